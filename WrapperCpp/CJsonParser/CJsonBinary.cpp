@@ -0,0 +1,845 @@
+#include "CJsonBinary.h"
+#include "CJsonFileMap.h"
+#include "CJsonFileWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+namespace
+{
+	//ģʽ»ﵽôСʱд
+	const size_t kBlockSize = 64 * 1024;
+	//Ƕײ(jsoncppȡstackLimitһ)
+	const int kMaxDepth = 1000;
+
+	//ֿд
+	using BlockWriter = std::function<bool(const char*, size_t)>;
+
+	//ֽ(дʱֿд)
+	class ByteSink
+	{
+	public:
+		ByteSink(std::vector<uint8_t>& buffer, const BlockWriter* write)
+			: m_buffer(buffer), m_write(write) {}
+		void Put(uint8_t b) { m_buffer.push_back(b); }
+		void Put(const char* data, size_t size)
+		{
+			m_buffer.insert(m_buffer.end(), data, data + size);
+		}
+		//дĵbytesֽ
+		void PutBE(uint64_t v, int bytes)
+		{
+			for (int i = bytes - 1; i >= 0; --i)
+				m_buffer.push_back(static_cast<uint8_t>(v >> (8 * i)));
+		}
+		bool Flush(bool force)
+		{
+			if (!m_write || (!force && m_buffer.size() < kBlockSize))
+				return true;
+			bool ok = (*m_write)(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+			m_buffer.clear();
+			return ok;
+		}
+	private:
+		std::vector<uint8_t>& m_buffer;
+		const BlockWriter* m_write;
+	};
+
+	bool EncodeBlocks(const Json::Value& value, CJsonBinary::Format format, const BlockWriter& write);
+
+	class Encoder
+	{
+	public:
+		Encoder(ByteSink& sink, CJsonBinary::Format format)
+			: m_sink(sink), m_format(format) {}
+		bool Write(const Json::Value& v)
+		{
+			switch (v.type())
+			{
+			case Json::nullValue:
+				m_sink.Put(m_format == CJsonBinary::CBOR ? 0xF6 : 0xC0);
+				break;
+			case Json::booleanValue:
+				if (m_format == CJsonBinary::CBOR)
+					m_sink.Put(v.asBool() ? 0xF5 : 0xF4);
+				else
+					m_sink.Put(v.asBool() ? 0xC3 : 0xC2);
+				break;
+			case Json::intValue:
+				WriteInt(v.asLargestInt());
+				break;
+			case Json::uintValue:
+				WriteUInt(v.asLargestUInt());
+				break;
+			case Json::realValue:
+				WriteDouble(v.asDouble());
+				break;
+			case Json::stringValue:
+			{
+				const char* begin = nullptr;
+				const char* end = nullptr;
+				v.getString(&begin, &end);
+				WriteString(begin, static_cast<size_t>(end - begin));
+				break;
+			}
+			case Json::arrayValue:
+				WriteHead(4, v.size());
+				for (Json::ArrayIndex i = 0; i < v.size(); ++i)
+				{
+					if (!Write(v[i]))
+						return false;
+				}
+				break;
+			case Json::objectValue:
+				WriteHead(5, v.size());
+				for (Json::ValueConstIterator it = v.begin(); it != v.end(); ++it)
+				{
+					const char* end = nullptr;
+					const char* name = it.memberName(&end);
+					WriteString(name, static_cast<size_t>(end - name));
+					if (!Write(*it))
+						return false;
+				}
+				break;
+			}
+			return m_sink.Flush(false);
+		}
+	private:
+		//CBOR볤ͷ(major: 0 1 3ַ 4 5),MessagePackͬ
+		void WriteHead(uint8_t major, uint64_t n)
+		{
+			if (m_format == CJsonBinary::CBOR)
+			{
+				uint8_t type = static_cast<uint8_t>(major << 5);
+				if (n < 24)
+					m_sink.Put(static_cast<uint8_t>(type | n));
+				else if (n <= 0xFF)
+				{
+					m_sink.Put(type | 24);
+					m_sink.PutBE(n, 1);
+				}
+				else if (n <= 0xFFFF)
+				{
+					m_sink.Put(type | 25);
+					m_sink.PutBE(n, 2);
+				}
+				else if (n <= 0xFFFFFFFFu)
+				{
+					m_sink.Put(type | 26);
+					m_sink.PutBE(n, 4);
+				}
+				else
+				{
+					m_sink.Put(type | 27);
+					m_sink.PutBE(n, 8);
+				}
+				return;
+			}
+			switch (major)
+			{
+			case 3:
+				if (n < 32)
+					m_sink.Put(static_cast<uint8_t>(0xA0 | n));
+				else if (n <= 0xFF)
+				{
+					m_sink.Put(0xD9);
+					m_sink.PutBE(n, 1);
+				}
+				else if (n <= 0xFFFF)
+				{
+					m_sink.Put(0xDA);
+					m_sink.PutBE(n, 2);
+				}
+				else
+				{
+					m_sink.Put(0xDB);
+					m_sink.PutBE(n, 4);
+				}
+				break;
+			case 4:
+			case 5:
+				if (n < 16)
+					m_sink.Put(static_cast<uint8_t>((major == 4 ? 0x90 : 0x80) | n));
+				else if (n <= 0xFFFF)
+				{
+					m_sink.Put(major == 4 ? 0xDC : 0xDE);
+					m_sink.PutBE(n, 2);
+				}
+				else
+				{
+					m_sink.Put(major == 4 ? 0xDD : 0xDF);
+					m_sink.PutBE(n, 4);
+				}
+				break;
+			}
+		}
+		void WriteUInt(uint64_t n)
+		{
+			if (m_format == CJsonBinary::CBOR)
+				WriteHead(0, n);
+			else if (n < 128)
+				m_sink.Put(static_cast<uint8_t>(n));
+			else if (n <= 0xFF)
+			{
+				m_sink.Put(0xCC);
+				m_sink.PutBE(n, 1);
+			}
+			else if (n <= 0xFFFF)
+			{
+				m_sink.Put(0xCD);
+				m_sink.PutBE(n, 2);
+			}
+			else if (n <= 0xFFFFFFFFu)
+			{
+				m_sink.Put(0xCE);
+				m_sink.PutBE(n, 4);
+			}
+			else
+			{
+				m_sink.Put(0xCF);
+				m_sink.PutBE(n, 8);
+			}
+		}
+		void WriteInt(int64_t n)
+		{
+			if (n >= 0)
+			{
+				WriteUInt(static_cast<uint64_t>(n));
+				return;
+			}
+			if (m_format == CJsonBinary::CBOR)
+			{
+				//CBOR洢-1-n
+				WriteHead(1, static_cast<uint64_t>(-1 - n));
+				return;
+			}
+			uint64_t bits = static_cast<uint64_t>(n);
+			if (n >= -32)
+				m_sink.Put(static_cast<uint8_t>(bits));
+			else if (n >= -128)
+			{
+				m_sink.Put(0xD0);
+				m_sink.PutBE(bits, 1);
+			}
+			else if (n >= -32768)
+			{
+				m_sink.Put(0xD1);
+				m_sink.PutBE(bits, 2);
+			}
+			else if (n >= std::numeric_limits<int32_t>::min())
+			{
+				m_sink.Put(0xD2);
+				m_sink.PutBE(bits, 4);
+			}
+			else
+			{
+				m_sink.Put(0xD3);
+				m_sink.PutBE(bits, 8);
+			}
+		}
+		void WriteDouble(double d)
+		{
+			//תΪʱֻռ4ֽ
+			float f = static_cast<float>(d);
+			if (static_cast<double>(f) == d)
+			{
+				uint32_t bits = 0;
+				std::memcpy(&bits, &f, sizeof(bits));
+				m_sink.Put(m_format == CJsonBinary::CBOR ? 0xFA : 0xCA);
+				m_sink.PutBE(bits, 4);
+				return;
+			}
+			uint64_t bits = 0;
+			std::memcpy(&bits, &d, sizeof(bits));
+			m_sink.Put(m_format == CJsonBinary::CBOR ? 0xFB : 0xCB);
+			m_sink.PutBE(bits, 8);
+		}
+		void WriteString(const char* data, size_t size)
+		{
+			WriteHead(3, size);
+			m_sink.Put(data, size);
+		}
+		ByteSink& m_sink;
+		CJsonBinary::Format m_format;
+	};
+
+	//ڴԴ
+	class MemorySource
+	{
+	public:
+		MemorySource(const uint8_t* begin, const uint8_t* end)
+			: m_cur(begin), m_end(end) {}
+		bool Read(uint8_t* dst, size_t n)
+		{
+			if (n > Remaining())
+				return false;
+			std::memcpy(dst, m_cur, n);
+			m_cur += n;
+			return true;
+		}
+		bool Peek(uint8_t& b)
+		{
+			if (m_cur == m_end)
+				return false;
+			b = *m_cur;
+			return true;
+		}
+		//ȡnֽ(ֱָԴ)
+		const char* Span(size_t n, Json::String&)
+		{
+			if (n > Remaining())
+				return nullptr;
+			const char* p = reinterpret_cast<const char*>(m_cur);
+			m_cur += n;
+			return p;
+		}
+		size_t Remaining() const { return static_cast<size_t>(m_end - m_cur); }
+		bool AtEnd() { return m_cur == m_end; }
+	private:
+		const uint8_t* m_cur;
+		const uint8_t* m_end;
+	};
+
+	//Դ(ȡ)
+	class StreamSource
+	{
+	public:
+		explicit StreamSource(std::istream& is)
+			: m_is(is), m_buffer(kBlockSize) {}
+		bool Read(uint8_t* dst, size_t n)
+		{
+			while (n > 0)
+			{
+				if (m_pos == m_size && !Fill())
+					return false;
+				size_t count = std::min(n, m_size - m_pos);
+				std::memcpy(dst, m_buffer.data() + m_pos, count);
+				m_pos += count;
+				dst += count;
+				n -= count;
+			}
+			return true;
+		}
+		bool Peek(uint8_t& b)
+		{
+			if (m_pos == m_size && !Fill())
+				return false;
+			b = static_cast<uint8_t>(m_buffer[m_pos]);
+			return true;
+		}
+		//ȡnֽ(Ƶscratch,Ȳʱֿ)
+		const char* Span(size_t n, Json::String& scratch)
+		{
+			scratch.clear();
+			while (scratch.size() < n)
+			{
+				if (m_pos == m_size && !Fill())
+					return nullptr;
+				size_t count = std::min(n - scratch.size(), m_size - m_pos);
+				scratch.append(m_buffer.data() + m_pos, count);
+				m_pos += count;
+			}
+			return scratch.data();
+		}
+		size_t Remaining() const { return std::numeric_limits<size_t>::max(); }
+		bool AtEnd()
+		{
+			return m_pos == m_size && !Fill();
+		}
+	private:
+		bool Fill()
+		{
+			m_is.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+			m_size = static_cast<size_t>(m_is.gcount());
+			m_pos = 0;
+			return m_size > 0;
+		}
+		std::istream& m_is;
+		std::vector<char> m_buffer;
+		size_t m_pos = 0;
+		size_t m_size = 0;
+	};
+
+	template <typename Source>
+	class Decoder
+	{
+	public:
+		Decoder(Source& source, CJsonBinary::Format format)
+			: m_source(source), m_format(format) {}
+		bool Decode(Json::Value& value)
+		{
+			if (!ReadValue(value, 0))
+				return false;
+			if (!m_source.AtEnd())
+				return Fail("Extra data after the value");
+			return true;
+		}
+		const Json::String& GetErrorInfo() const { return m_errInfo; }
+	private:
+		bool Fail(const Json::String& message)
+		{
+			if (m_errInfo.empty())
+				m_errInfo = message;
+			return false;
+		}
+		bool ReadByte(uint8_t& b)
+		{
+			return m_source.Read(&b, 1) || Fail("Unexpected end of data");
+		}
+		bool ReadBE(int bytes, uint64_t& v)
+		{
+			uint8_t data[8];
+			if (!m_source.Read(data, static_cast<size_t>(bytes)))
+				return Fail("Unexpected end of data");
+			v = 0;
+			for (int i = 0; i < bytes; ++i)
+				v = (v << 8) | data[i];
+			return true;
+		}
+		//jsoncppȡһ:зűʾʱΪintValue
+		static Json::Value MakeUInt(uint64_t n)
+		{
+			if (n <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+				return Json::Value(static_cast<Json::Int64>(n));
+			return Json::Value(static_cast<Json::UInt64>(n));
+		}
+		static double FloatFromBits(uint32_t bits)
+		{
+			float f;
+			std::memcpy(&f, &bits, sizeof(f));
+			return f;
+		}
+		static double DoubleFromBits(uint64_t bits)
+		{
+			double d;
+			std::memcpy(&d, &bits, sizeof(d));
+			return d;
+		}
+		static double HalfFromBits(uint16_t half)
+		{
+			int exponent = (half >> 10) & 0x1F;
+			int mantissa = half & 0x3FF;
+			double value;
+			if (exponent == 0)
+				value = std::ldexp(mantissa, -24);
+			else if (exponent != 31)
+				value = std::ldexp(mantissa + 1024, exponent - 25);
+			else
+				value = mantissa == 0 ? std::numeric_limits<double>::infinity()
+					: std::numeric_limits<double>::quiet_NaN();
+			return (half & 0x8000) ? -value : value;
+		}
+		//Ԫظܳʣֽ(ÿԪ1ֽ)
+		bool CheckCount(uint64_t n)
+		{
+			if (n > m_source.Remaining() || n > Json::Value::maxUInt)
+				return Fail("Length exceeds data");
+			return true;
+		}
+		bool ReadString(uint64_t n, Json::Value& value)
+		{
+			if (n > m_source.Remaining())
+				return Fail("Length exceeds data");
+			const char* p = m_source.Span(static_cast<size_t>(n), m_scratch);
+			if (!p)
+				return Fail("Unexpected end of data");
+			value = Json::Value(p, p + n);
+			return true;
+		}
+		//ȡļضӦԱ
+		bool ReadMember(Json::Value& object, Json::Value*& member, int depth)
+		{
+			uint8_t b = 0;
+			if (!m_source.Peek(b))
+				return Fail("Unexpected end of data");
+			uint64_t n = 0;
+			bool plain = false;
+			if (m_format == CJsonBinary::CBOR && (b >> 5) == 3 && (b & 31) < 28)
+			{
+				//ıֱӲ,ʱ
+				m_source.Read(&b, 1);
+				if (!ReadArgument(b & 31, n))
+					return false;
+				plain = true;
+			}
+			else if (m_format == CJsonBinary::MessagePack && ((b >= 0xA0 && b <= 0xBF) || (b >= 0xD9 && b <= 0xDB)))
+			{
+				m_source.Read(&b, 1);
+				if (b <= 0xBF)
+					n = b & 0x1F;
+				else if (!ReadBE(1 << (b - 0xD9), n))
+					return false;
+				plain = true;
+			}
+			if (plain)
+			{
+				if (n > m_source.Remaining())
+					return Fail("Length exceeds data");
+				const char* p = m_source.Span(static_cast<size_t>(n), m_scratch);
+				if (!p)
+					return Fail("Unexpected end of data");
+				member = object.demand(p, p + n);
+				return true;
+			}
+			//͵ļתΪַ
+			Json::Value key;
+			if (!ReadValue(key, depth + 1))
+				return false;
+			if (key.isString() || key.isIntegral() || key.isBool())
+			{
+				Json::String name = key.asString();
+				member = object.demand(name.data(), name.data() + name.size());
+				return true;
+			}
+			return Fail("Unsupported object key type");
+		}
+		//CBORͷĳȲ
+		bool ReadArgument(uint8_t info, uint64_t& n)
+		{
+			if (info < 24)
+			{
+				n = info;
+				return true;
+			}
+			if (info > 27)
+				return Fail("Invalid CBOR length");
+			return ReadBE(1 << (info - 24), n);
+		}
+		bool ReadValue(Json::Value& value, int depth)
+		{
+			if (depth > kMaxDepth)
+				return Fail("Exceeded stack limit");
+			return m_format == CJsonBinary::CBOR ? ReadCbor(value, depth) : ReadMsgPack(value, depth);
+		}
+		bool IsBreak()
+		{
+			uint8_t b = 0;
+			if (m_source.Peek(b) && b == 0xFF)
+			{
+				m_source.Read(&b, 1);
+				return true;
+			}
+			return false;
+		}
+		bool ReadCbor(Json::Value& value, int depth)
+		{
+			uint8_t b = 0;
+			if (!ReadByte(b))
+				return false;
+			uint8_t major = b >> 5;
+			uint8_t info = b & 31;
+			if (major == 7)
+			{
+				uint64_t bits = 0;
+				switch (info)
+				{
+				case 20: value = false; return true;
+				case 21: value = true; return true;
+				case 22:
+				case 23: value = Json::Value(); return true;
+				case 25:
+					if (!ReadBE(2, bits))
+						return false;
+					value = HalfFromBits(static_cast<uint16_t>(bits));
+					return true;
+				case 26:
+					if (!ReadBE(4, bits))
+						return false;
+					value = FloatFromBits(static_cast<uint32_t>(bits));
+					return true;
+				case 27:
+					if (!ReadBE(8, bits))
+						return false;
+					value = DoubleFromBits(bits);
+					return true;
+				default:
+					return Fail("Unsupported CBOR simple value");
+				}
+			}
+			//ַ,
+			if (info == 31)
+			{
+				switch (major)
+				{
+				case 2:
+				case 3:
+				{
+					Json::String text;
+					while (!IsBreak())
+					{
+						Json::Value chunk;
+						uint8_t cb = 0;
+						if (!m_source.Peek(cb) || (cb >> 5) != major || (cb & 31) == 31)
+							return Fail("Invalid CBOR string chunk");
+						if (!ReadCbor(chunk, depth + 1))
+							return false;
+						const char* begin = nullptr;
+						const char* end = nullptr;
+						chunk.getString(&begin, &end);
+						text.append(begin, end);
+					}
+					value = Json::Value(text);
+					return true;
+				}
+				case 4:
+					value = Json::Value(Json::arrayValue);
+					while (!IsBreak())
+					{
+						if (!ReadValue(value.append(Json::Value()), depth + 1))
+							return false;
+					}
+					return true;
+				case 5:
+					value = Json::Value(Json::objectValue);
+					while (!IsBreak())
+					{
+						Json::Value* member = nullptr;
+						if (!ReadMember(value, member, depth) || !ReadValue(*member, depth + 1))
+							return false;
+					}
+					return true;
+				default:
+					return Fail("Invalid CBOR length");
+				}
+			}
+			uint64_t n = 0;
+			if (!ReadArgument(info, n))
+				return false;
+			switch (major)
+			{
+			case 0:
+				value = MakeUInt(n);
+				return true;
+			case 1:
+				if (n <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+					value = Json::Value(static_cast<Json::Int64>(-1 - static_cast<int64_t>(n)));
+				else
+					value = -1.0 - static_cast<double>(n);
+				return true;
+			case 2:
+			case 3:
+				return ReadString(n, value);
+			case 4:
+				if (!CheckCount(n))
+					return false;
+				value = Json::Value(Json::arrayValue);
+				for (uint64_t i = 0; i < n; ++i)
+				{
+					if (!ReadValue(value.append(Json::Value()), depth + 1))
+						return false;
+				}
+				return true;
+			case 5:
+				if (!CheckCount(n))
+					return false;
+				value = Json::Value(Json::objectValue);
+				for (uint64_t i = 0; i < n; ++i)
+				{
+					Json::Value* member = nullptr;
+					if (!ReadMember(value, member, depth) || !ReadValue(*member, depth + 1))
+						return false;
+				}
+				return true;
+			default:
+				//ǩֻ
+				return ReadValue(value, depth + 1);
+			}
+		}
+		bool ReadMsgPack(Json::Value& value, int depth)
+		{
+			uint8_t b = 0;
+			if (!ReadByte(b))
+				return false;
+			uint64_t n = 0;
+			if (b <= 0x7F)
+			{
+				value = MakeUInt(b);
+				return true;
+			}
+			if (b >= 0xE0)
+			{
+				value = Json::Value(static_cast<Json::Int64>(static_cast<int8_t>(b)));
+				return true;
+			}
+			if (b >= 0xA0 && b <= 0xBF)
+				return ReadString(b & 0x1F, value);
+			if (b >= 0x90 && b <= 0x9F)
+				return ReadArray(b & 0x0F, value, depth);
+			if (b >= 0x80 && b <= 0x8F)
+				return ReadMap(b & 0x0F, value, depth);
+			switch (b)
+			{
+			case 0xC0: value = Json::Value(); return true;
+			case 0xC2: value = false; return true;
+			case 0xC3: value = true; return true;
+			case 0xC4:
+			case 0xC5:
+			case 0xC6:
+				//ݰֽڱΪַ
+				return ReadBE(1 << (b - 0xC4), n) && ReadString(n, value);
+			case 0xCA:
+				if (!ReadBE(4, n))
+					return false;
+				value = FloatFromBits(static_cast<uint32_t>(n));
+				return true;
+			case 0xCB:
+				if (!ReadBE(8, n))
+					return false;
+				value = DoubleFromBits(n);
+				return true;
+			case 0xCC:
+			case 0xCD:
+			case 0xCE:
+			case 0xCF:
+				if (!ReadBE(1 << (b - 0xCC), n))
+					return false;
+				value = MakeUInt(n);
+				return true;
+			case 0xD0:
+			case 0xD1:
+			case 0xD2:
+			case 0xD3:
+			{
+				int bytes = 1 << (b - 0xD0);
+				if (!ReadBE(bytes, n))
+					return false;
+				//չ
+				int shift = 64 - 8 * bytes;
+				int64_t v = static_cast<int64_t>(n << shift) >> shift;
+				value = Json::Value(static_cast<Json::Int64>(v));
+				return true;
+			}
+			case 0xD9:
+			case 0xDA:
+			case 0xDB:
+				return ReadBE(1 << (b - 0xD9), n) && ReadString(n, value);
+			case 0xDC:
+			case 0xDD:
+				return ReadBE(b == 0xDC ? 2 : 4, n) && ReadArray(n, value, depth);
+			case 0xDE:
+			case 0xDF:
+				return ReadBE(b == 0xDE ? 2 : 4, n) && ReadMap(n, value, depth);
+			default:
+				return Fail("Unsupported MessagePack type");
+			}
+		}
+		bool ReadArray(uint64_t n, Json::Value& value, int depth)
+		{
+			if (!CheckCount(n))
+				return false;
+			value = Json::Value(Json::arrayValue);
+			for (uint64_t i = 0; i < n; ++i)
+			{
+				if (!ReadValue(value.append(Json::Value()), depth + 1))
+					return false;
+			}
+			return true;
+		}
+		bool ReadMap(uint64_t n, Json::Value& value, int depth)
+		{
+			if (!CheckCount(n))
+				return false;
+			value = Json::Value(Json::objectValue);
+			for (uint64_t i = 0; i < n; ++i)
+			{
+				Json::Value* member = nullptr;
+				if (!ReadMember(value, member, depth) || !ReadValue(*member, depth + 1))
+					return false;
+			}
+			return true;
+		}
+		Source& m_source;
+		CJsonBinary::Format m_format;
+		Json::String m_scratch;
+		Json::String m_errInfo;
+	};
+
+	template <typename Source>
+	bool DecodeFrom(Source& source, CJsonBinary::Format format, Json::Value& value, Json::String* err)
+	{
+		Decoder<Source> decoder(source, format);
+		Json::Value result;
+		if (!decoder.Decode(result))
+		{
+			if (err)
+				*err = decoder.GetErrorInfo();
+			return false;
+		}
+		value.swap(result);
+		return true;
+	}
+
+	bool EncodeBlocks(const Json::Value& value, CJsonBinary::Format format, const BlockWriter& write)
+	{
+		std::vector<uint8_t> buffer;
+		buffer.reserve(kBlockSize + 64);
+		ByteSink sink(buffer, &write);
+		return Encoder(sink, format).Write(value) && sink.Flush(true);
+	}
+}
+
+void CJsonBinary::Encode(const Json::Value& value, Format format, std::vector<uint8_t>& out)
+{
+	ByteSink sink(out, nullptr);
+	Encoder(sink, format).Write(value);
+}
+
+bool CJsonBinary::Encode(const Json::Value& value, Format format, std::ostream& os)
+{
+	return EncodeBlocks(value, format, [&os](const char* data, size_t size)
+	{
+		os.write(data, static_cast<std::streamsize>(size));
+		return os.good();
+	});
+}
+
+bool CJsonBinary::Decode(const uint8_t* begin, const uint8_t* end, Format format,
+	Json::Value& value, Json::String* err)
+{
+	MemorySource source(begin, end);
+	return DecodeFrom(source, format, value, err);
+}
+
+bool CJsonBinary::Decode(const std::vector<uint8_t>& data, Format format,
+	Json::Value& value, Json::String* err)
+{
+	return Decode(data.data(), data.data() + data.size(), format, value, err);
+}
+
+bool CJsonBinary::Decode(std::istream& is, Format format, Json::Value& value, Json::String* err)
+{
+	StreamSource source(is);
+	return DecodeFrom(source, format, value, err);
+}
+
+bool CJsonBinary::SaveFile(const Json::Value& value, const Json::String& file, Format format, bool sync)
+{
+	//ıһдʱļٸ,;ʧܻƻԭļ
+	CJsonFileWriter ofile;
+	if (!ofile.Open(file))
+		return false;
+	if (!EncodeBlocks(value, format, [&ofile](const char* data, size_t size)
+		{
+			return ofile.Write(data, size);
+		}))
+		return false;
+	return ofile.Commit(sync);
+}
+
+bool CJsonBinary::LoadFile(const Json::String& file, Format format, Json::Value& value,
+	Json::String* err)
+{
+	CJsonFileMap map;
+	if (!map.Open(file))
+	{
+		if (err)
+			*err = "Failed to open file: " + file;
+		return false;
+	}
+	const uint8_t* begin = reinterpret_cast<const uint8_t*>(map.Begin());
+	return Decode(begin, begin + map.Size(), format, value, err);
+}
@@ -0,0 +1,36 @@
+#ifndef CJSON_BINARY_H
+#define CJSON_BINARY_H
+
+#include "jsoncpp/json.h"
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+//JsonݵĶƱ(CBORMessagePack),ֱJsonֽ֮ת,ı
+class CJsonBinary
+{
+public:
+	enum Format
+	{
+		CBOR,			//RFC 8949
+		MessagePack
+	};
+	//벢׷ӵ
+	static void Encode(const Json::Value& value, Format format, std::vector<uint8_t>& out);
+	//벢ֿд
+	static bool Encode(const Json::Value& value, Format format, std::ostream& os);
+	//ڴ(ݱǡһֵ)
+	static bool Decode(const uint8_t* begin, const uint8_t* end, Format format,
+		Json::Value& value, Json::String* err = nullptr);
+	static bool Decode(const std::vector<uint8_t>& data, Format format,
+		Json::Value& value, Json::String* err = nullptr);
+	//ֿȡһֵ
+	static bool Decode(std::istream& is, Format format, Json::Value& value,
+		Json::String* err = nullptr);
+	//ضļ(ʱдʱļٸ,syncΪtrueʱˢ̺ŷ)
+	static bool SaveFile(const Json::Value& value, const Json::String& file, Format format,
+		bool sync = false);
+	static bool LoadFile(const Json::String& file, Format format, Json::Value& value,
+		Json::String* err = nullptr);
+};
+
+#endif	//CJSON_BINARY_H
@@ -0,0 +1,250 @@
+#include "CJsonBinding.h"
+
+namespace
+{
+	using CJsonBindingDetail::Scalar;
+	using CJsonBindingDetail::Target;
+
+	//¼󶨶:ջбĶ,δֵ֪
+	class BindingReader : public Json::ValueHandler
+	{
+	public:
+		explicit BindingReader(Target root)
+			: m_next(root)
+		{
+		}
+		bool onNull() override
+		{
+			Scalar value = {};
+			value.type = Json::nullValue;
+			return OnScalar(value);
+		}
+		bool onBool(bool b) override
+		{
+			Scalar value = {};
+			value.type = Json::booleanValue;
+			value.boolValue = b;
+			return OnScalar(value);
+		}
+		bool onInt(Json::LargestInt i) override
+		{
+			Scalar value = {};
+			value.type = Json::intValue;
+			value.intValue = i;
+			return OnScalar(value);
+		}
+		bool onUInt(Json::LargestUInt u) override
+		{
+			Scalar value = {};
+			value.type = Json::uintValue;
+			value.uintValue = u;
+			return OnScalar(value);
+		}
+		bool onDouble(double d) override
+		{
+			Scalar value = {};
+			value.type = Json::realValue;
+			value.realValue = d;
+			return OnScalar(value);
+		}
+		bool onString(const char* begin, const char* end) override
+		{
+			Scalar value = {};
+			value.type = Json::stringValue;
+			value.begin = begin;
+			value.end = end;
+			return OnScalar(value);
+		}
+		bool onStartObject() override
+		{
+			if (m_skip)
+			{
+				++m_skip;
+				return true;
+			}
+			Target target = Next();
+			if (!target.ops)
+			{
+				m_skip = 1;
+				return true;
+			}
+			if (!target.ops->key)
+				return Mismatch();
+			m_stack.push_back(frame{ target, false, nullptr });
+			return true;
+		}
+		bool onKey(const char* begin, const char* end) override
+		{
+			if (m_skip)
+				return true;
+			frame& top = m_stack.back();
+			top.field = top.target.ops->key(top.target.ptr, begin, end, m_next);
+			return true;
+		}
+		bool onEndObject() override
+		{
+			return OnEnd();
+		}
+		bool onStartArray() override
+		{
+			if (m_skip)
+			{
+				++m_skip;
+				return true;
+			}
+			Target target = Next();
+			if (!target.ops)
+			{
+				m_skip = 1;
+				return true;
+			}
+			if (!target.ops->element)
+				return Mismatch();
+			target.ops->clear(target.ptr);
+			m_stack.push_back(frame{ target, true, nullptr });
+			return true;
+		}
+		bool onEndArray() override
+		{
+			return OnEnd();
+		}
+		//Json¼,δֵ֪
+		bool Walk(const Json::Value& value)
+		{
+			switch (value.type())
+			{
+			case Json::nullValue:
+				return onNull();
+			case Json::booleanValue:
+				return onBool(value.asBool());
+			case Json::intValue:
+				return onInt(value.asLargestInt());
+			case Json::uintValue:
+				return onUInt(value.asLargestUInt());
+			case Json::realValue:
+				return onDouble(value.asDouble());
+			case Json::stringValue:
+			{
+				const char* begin = nullptr;
+				const char* end = nullptr;
+				value.getString(&begin, &end);
+				return onString(begin, end);
+			}
+			case Json::arrayValue:
+				if (!onStartArray())
+					return false;
+				for (Json::ArrayIndex i = 0; i < value.size(); ++i)
+				{
+					if (!Walk(value[i]))
+						return false;
+				}
+				return onEndArray();
+			case Json::objectValue:
+				if (!onStartObject())
+					return false;
+				for (Json::Value::const_iterator it = value.begin(); it != value.end(); ++it)
+				{
+					const char* end = nullptr;
+					const char* name = it.memberName(&end);
+					onKey(name, end);
+					if (m_next.ops && !Walk(*it))
+						return false;
+				}
+				return onEndObject();
+			}
+			return true;
+		}
+		const Json::String& GetErrorInfo() const { return m_errInfo; }
+	private:
+		struct frame
+		{
+			Target target;
+			bool isArray;
+			//еǰӦֶ(ڴϢ)
+			const char* field;
+		};
+		//һֵĿ:׷Ԫ,ȡǰֶ
+		Target Next()
+		{
+			if (!m_stack.empty() && m_stack.back().isArray)
+			{
+				const Target& array = m_stack.back().target;
+				return array.ops->element(array.ptr);
+			}
+			Target target = m_next;
+			m_next = Target{ nullptr, nullptr };
+			return target;
+		}
+		bool OnScalar(const Scalar& value)
+		{
+			if (m_skip)
+				return true;
+			Target target = Next();
+			//δ֪null:ԭֵ
+			if (!target.ops || value.type == Json::nullValue)
+				return true;
+			if (!target.ops->scalar || !target.ops->scalar(target.ptr, value))
+				return Mismatch();
+			return true;
+		}
+		bool OnEnd()
+		{
+			if (m_skip)
+			{
+				--m_skip;
+				return true;
+			}
+			m_stack.pop_back();
+			return true;
+		}
+		//¼Ͳλòֹͣ
+		bool Mismatch()
+		{
+			Json::String path;
+			for (const frame& f : m_stack)
+			{
+				if (f.isArray)
+					path += "[]";
+				else if (f.field)
+				{
+					if (!path.empty())
+						path += ".";
+					path += f.field;
+				}
+			}
+			m_errInfo = "Value type does not match field: " + (path.empty() ? Json::String("(root)") : path);
+			return false;
+		}
+		std::vector<frame> m_stack;
+		Target m_next;
+		//δֵ֪Ƕ
+		size_t m_skip = 0;
+		Json::String m_errInfo;
+	};
+}
+
+bool CJsonBindingDetail::ReadJson(const char* begin, const char* end, Target root, Json::String* err)
+{
+	BindingReader reader(root);
+	Json::CharReaderBuilder ReaderBuilder;
+	Json::String errs;
+	bool ok = Json::parseEvents(ReaderBuilder, begin, end, reader, &errs);
+	//ֹͣʱparseEventstrue
+	if (ok && !reader.GetErrorInfo().empty())
+	{
+		ok = false;
+		errs = reader.GetErrorInfo();
+	}
+	if (err)
+		*err = errs;
+	return ok;
+}
+
+bool CJsonBindingDetail::ReadValue(const Json::Value& value, Target root, Json::String* err)
+{
+	BindingReader reader(root);
+	bool ok = reader.Walk(value);
+	if (err)
+		*err = reader.GetErrorInfo();
+	return ok;
+}
@@ -0,0 +1,414 @@
+#ifndef CJSON_BINDING_H
+#define CJSON_BINDING_H
+
+#include "jsoncpp/json.h"
+#include "CJsonWriter.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//ṹJson֮ıڰ:ֶαΪconstexpr,лֱдַ,лɽ¼Jsonֱ
+//ֵ֧ĳԱ:bool,,,Json::String,std::vectorѰ󶨵Ľṹ
+//÷(ȫռа):
+//	struct Point { int x; int y; Json::String name; };
+//	CJSON_BIND(Point, CJSON_FIELD(Point, x), CJSON_FIELD(Point, y), CJSON_FIELD_NAMED(Point, name, "label"))
+//	Json::String json = CJsonBinding::ToJson(point);
+//	bool ok = CJsonBinding::FromJson(json, point, &err);
+
+//ֶα,CJSON_BINDػ
+template <class T>
+struct CJsonFields
+{
+};
+
+namespace CJsonBindingDetail
+{
+	//Ĺϣ(FNV-1a),ֶĹϣڱڼ
+	constexpr uint64_t Hash(const char* p, size_t size)
+	{
+		uint64_t h = 14695981039346656037ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= static_cast<unsigned char>(p[i]);
+			h *= 1099511628211ull;
+		}
+		return h;
+	}
+
+	//ֶ:,ĹϣԱָ
+	template <class T, class M>
+	struct Field
+	{
+		using Type = M;
+		const char* name;
+		size_t size;
+		uint64_t hash;
+		M T::* member;
+	};
+
+	template <class T, class M, size_t N>
+	constexpr Field<T, M> MakeField(const char (&name)[N], M T::* member)
+	{
+		return Field<T, M>{ name, N - 1, Hash(name, N - 1), member };
+	}
+
+	template <class T, class = void>
+	struct IsBound : std::false_type
+	{
+	};
+	template <class T>
+	struct IsBound<T, std::void_t<decltype(CJsonFields<T>::value)>> : std::true_type
+	{
+	};
+
+	//õļֵ
+	struct Scalar
+	{
+		Json::ValueType type;
+		bool boolValue;
+		Json::LargestInt intValue;
+		Json::LargestUInt uintValue;
+		double realValue;
+		const char* begin;
+		const char* end;
+	};
+
+	struct TypeOps;
+	//лĿ:ַ͵Ĳ(opsΪnullptrʱֵ)
+	struct Target
+	{
+		void* ptr;
+		const TypeOps* ops;
+	};
+
+	//лʱһ͵Ĳ,ֵ֧JsonͶӦĺΪnullptr
+	struct TypeOps
+	{
+		//дֵ,Ͳ򳬳Χfalse
+		bool (*scalar)(void* target, const Scalar& value);
+		//:ֶ,ֶchild,δ֪nullptr
+		const char* (*key)(void* target, const char* begin, const char* end, Target& child);
+		//:ʼʱ,ÿԪ׷һ
+		void (*clear)(void* target);
+		Target (*element)(void* target);
+	};
+
+	//ɽ¼Jsonroot
+	bool ReadJson(const char* begin, const char* end, Target root, Json::String* err);
+	bool ReadValue(const Json::Value& value, Target root, Json::String* err);
+
+	template <class T, class = void>
+	struct Codec;
+
+	template <>
+	struct Codec<bool>
+	{
+		static void Write(Json::String& out, bool value)
+		{
+			if (value)
+				out.append("true", 4);
+			else
+				out.append("false", 5);
+		}
+		static bool Read(void* target, const Scalar& value)
+		{
+			if (value.type != Json::booleanValue)
+				return false;
+			*static_cast<bool*>(target) = value.boolValue;
+			return true;
+		}
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { &Read, nullptr, nullptr, nullptr };
+			return &ops;
+		}
+	};
+
+	template <class T>
+	struct Codec<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+	{
+		static void Write(Json::String& out, T value)
+		{
+			char buffer[24];
+			std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			out.append(buffer, r.ptr);
+		}
+		static bool Read(void* target, const Scalar& value)
+		{
+			using limits = std::numeric_limits<T>;
+			T& out = *static_cast<T*>(target);
+			switch (value.type)
+			{
+			case Json::intValue:
+				if (value.intValue < 0 && (!limits::is_signed
+					|| value.intValue < static_cast<Json::LargestInt>(limits::min())))
+					return false;
+				if (value.intValue > 0 && static_cast<Json::LargestUInt>(value.intValue)
+					> static_cast<Json::LargestUInt>(limits::max()))
+					return false;
+				out = static_cast<T>(value.intValue);
+				return true;
+			case Json::uintValue:
+				if (value.uintValue > static_cast<Json::LargestUInt>(limits::max()))
+					return false;
+				out = static_cast<T>(value.uintValue);
+				return true;
+			case Json::realValue:
+				//ֻܷΧڵֵ(max + 1.02,Ծȷʾ)
+				if (std::floor(value.realValue) != value.realValue
+					|| value.realValue < static_cast<double>(limits::min())
+					|| value.realValue >= static_cast<double>(limits::max()) + 1.0)
+					return false;
+				out = static_cast<T>(value.realValue);
+				return true;
+			default:
+				return false;
+			}
+		}
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { &Read, nullptr, nullptr, nullptr };
+			return &ops;
+		}
+	};
+
+	template <class T>
+	struct Codec<T, std::enable_if_t<std::is_floating_point<T>::value>>
+	{
+		static void Write(Json::String& out, T value)
+		{
+			CJsonWriter::AppendDouble(out, static_cast<double>(value));
+		}
+		static bool Read(void* target, const Scalar& value)
+		{
+			T& out = *static_cast<T*>(target);
+			switch (value.type)
+			{
+			case Json::intValue:
+				out = static_cast<T>(value.intValue);
+				return true;
+			case Json::uintValue:
+				out = static_cast<T>(value.uintValue);
+				return true;
+			case Json::realValue:
+				out = static_cast<T>(value.realValue);
+				return true;
+			default:
+				return false;
+			}
+		}
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { &Read, nullptr, nullptr, nullptr };
+			return &ops;
+		}
+	};
+
+	template <>
+	struct Codec<Json::String>
+	{
+		static void Write(Json::String& out, const Json::String& value)
+		{
+			CJsonWriter::AppendString(out, value.data(), value.data() + value.size());
+		}
+		static bool Read(void* target, const Scalar& value)
+		{
+			if (value.type != Json::stringValue)
+				return false;
+			static_cast<Json::String*>(target)->assign(value.begin, value.end);
+			return true;
+		}
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { &Read, nullptr, nullptr, nullptr };
+			return &ops;
+		}
+	};
+
+	template <class E>
+	struct Codec<std::vector<E>>
+	{
+		static_assert(!std::is_same<E, bool>::value, "std::vector<bool> is not supported");
+		static void Write(Json::String& out, const std::vector<E>& value)
+		{
+			out.push_back('[');
+			for (size_t i = 0; i < value.size(); ++i)
+			{
+				if (i != 0)
+					out.push_back(',');
+				Codec<E>::Write(out, value[i]);
+			}
+			out.push_back(']');
+		}
+		static void Clear(void* target)
+		{
+			static_cast<std::vector<E>*>(target)->clear();
+		}
+		static Target Element(void* target)
+		{
+			std::vector<E>& v = *static_cast<std::vector<E>*>(target);
+			v.emplace_back();
+			return Target{ &v.back(), Codec<E>::Ops() };
+		}
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { nullptr, nullptr, &Clear, &Element };
+			return &ops;
+		}
+	};
+
+	//Ѱ󶨽ṹ:ֶα˳д,Ĺϣֶ
+	template <class T>
+	struct Codec<T, std::enable_if_t<IsBound<T>::value>>
+	{
+		static constexpr size_t kCount = std::tuple_size<decltype(CJsonFields<T>::value)>::value;
+
+		struct Entry
+		{
+			uint64_t hash;
+			size_t size;
+			const char* name;
+			void* (*member)(void*);
+			const TypeOps* ops;
+		};
+
+		template <size_t I>
+		static void* Member(void* target)
+		{
+			return &(static_cast<T*>(target)->*(std::get<I>(CJsonFields<T>::value).member));
+		}
+
+		template <size_t... I>
+		static std::array<Entry, kCount> MakeEntries(std::index_sequence<I...>)
+		{
+			return { { Entry{ std::get<I>(CJsonFields<T>::value).hash,
+				std::get<I>(CJsonFields<T>::value).size,
+				std::get<I>(CJsonFields<T>::value).name,
+				&Member<I>,
+				Codec<typename std::tuple_element<I,
+					std::remove_const_t<decltype(CJsonFields<T>::value)>>::type::Type>::Ops() }... } };
+		}
+
+		static const std::array<Entry, kCount>& Entries()
+		{
+			static const std::array<Entry, kCount> entries = MakeEntries(std::make_index_sequence<kCount>());
+			return entries;
+		}
+
+		//תðŵļ,ÿֻһ
+		static const std::array<Json::String, kCount>& Keys()
+		{
+			static const std::array<Json::String, kCount> keys = []()
+			{
+				std::array<Json::String, kCount> result;
+				for (size_t i = 0; i < kCount; ++i)
+				{
+					const Entry& e = Entries()[i];
+					CJsonWriter::AppendString(result[i], e.name, e.name + e.size);
+					result[i].push_back(':');
+				}
+				return result;
+			}();
+			return keys;
+		}
+
+		template <size_t... I>
+		static void WriteFields(Json::String& out, const T& value, std::index_sequence<I...>)
+		{
+			const std::array<Json::String, kCount>& keys = Keys();
+			(void)keys;
+			((out.append(I == 0 ? 0 : 1, ','), out.append(keys[I]),
+				Codec<typename std::tuple_element<I,
+					std::remove_const_t<decltype(CJsonFields<T>::value)>>::type::Type>::Write(
+					out, value.*(std::get<I>(CJsonFields<T>::value).member))), ...);
+		}
+
+		static void Write(Json::String& out, const T& value)
+		{
+			out.push_back('{');
+			WriteFields(out, value, std::make_index_sequence<kCount>());
+			out.push_back('}');
+		}
+
+		static const char* Key(void* target, const char* begin, const char* end, Target& child)
+		{
+			size_t size = static_cast<size_t>(end - begin);
+			uint64_t hash = Hash(begin, size);
+			for (const Entry& e : Entries())
+			{
+				if (e.hash == hash && e.size == size && std::memcmp(e.name, begin, size) == 0)
+				{
+					child = Target{ e.member(target), e.ops };
+					return e.name;
+				}
+			}
+			child = Target{ nullptr, nullptr };
+			return nullptr;
+		}
+
+		static const TypeOps* Ops()
+		{
+			static const TypeOps ops = { nullptr, &Key, nullptr, nullptr };
+			return &ops;
+		}
+	};
+}
+
+//ԳԱΪֶ
+#define CJSON_FIELD(type, member) CJsonBindingDetail::MakeField(#member, &type::member)
+//ֶָ
+#define CJSON_FIELD_NAMED(type, member, key) CJsonBindingDetail::MakeField(key, &type::member)
+//󶨽ṹֶα(ȫռʹ)
+#define CJSON_BIND(type, ...) \
+	template <> \
+	struct CJsonFields<type> \
+	{ \
+		static constexpr auto value = std::make_tuple(__VA_ARGS__); \
+	};
+
+//͵л뷴л
+class CJsonBinding
+{
+public:
+	//ոʽл׷ӵַ
+	template <class T>
+	static void ToJson(const T& value, Json::String& out)
+	{
+		CJsonBindingDetail::Codec<T>::Write(out, value);
+	}
+	template <class T>
+	static Json::String ToJson(const T& value)
+	{
+		Json::String out;
+		ToJson(value, out);
+		return out;
+	}
+	//Jsonıֱvalue(Json),δ֪,ڵļnullԭֵ
+	//ʧʱvalueѱ޸
+	template <class T>
+	static bool FromJson(const char* begin, const char* end, T& value, Json::String* err = nullptr)
+	{
+		return CJsonBindingDetail::ReadJson(begin, end,
+			CJsonBindingDetail::Target{ &value, CJsonBindingDetail::Codec<T>::Ops() }, err);
+	}
+	template <class T>
+	static bool FromJson(const Json::String& json, T& value, Json::String* err = nullptr)
+	{
+		return FromJson(json.data(), json.data() + json.size(), value, err);
+	}
+	//Jsonvalue,ͬFromJson
+	template <class T>
+	static bool FromValue(const Json::Value& json, T& value, Json::String* err = nullptr)
+	{
+		return CJsonBindingDetail::ReadValue(json,
+			CJsonBindingDetail::Target{ &value, CJsonBindingDetail::Codec<T>::Ops() }, err);
+	}
+};
+
+#endif	//CJSON_BINDING_H
@@ -0,0 +1,460 @@
+#include "CJsonColumns.h"
+#include "CJsonFileMap.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+namespace
+{
+	const std::vector<int64_t> g_noInts;
+	const std::vector<double> g_noDoubles;
+	const std::vector<std::string_view> g_noStrings;
+	const std::vector<uint8_t> g_noValid;
+}
+
+//¼ҵ·ָ,ԪصĳԱֱ
+class CJsonColumns::Reader : public Json::ValueHandler
+{
+public:
+	Reader(CJsonColumns& columns, const CJsonPath& path)
+		: m_columns(columns), m_tokens(path.m_tokens)
+	{
+	}
+	bool onNull() override
+	{
+		return BeginValue(scalarKind);
+	}
+	bool onBool(bool) override
+	{
+		if (!BeginValue(scalarKind))
+			return false;
+		return !IsField() || m_columns.Mismatch(m_column);
+	}
+	bool onInt(Json::LargestInt i) override
+	{
+		if (!BeginValue(scalarKind))
+			return false;
+		return !IsField() || m_columns.PutInt(m_column, i) || m_columns.Mismatch(m_column);
+	}
+	bool onUInt(Json::LargestUInt u) override
+	{
+		if (!BeginValue(scalarKind))
+			return false;
+		return !IsField() || m_columns.PutUInt(m_column, u) || m_columns.Mismatch(m_column);
+	}
+	bool onDouble(double d) override
+	{
+		if (!BeginValue(scalarKind))
+			return false;
+		return !IsField() || m_columns.PutDouble(m_column, d) || m_columns.Mismatch(m_column);
+	}
+	bool onString(const char* begin, const char* end) override
+	{
+		if (!BeginValue(scalarKind))
+			return false;
+		return !IsField() || m_columns.PutString(m_column, begin, end) || m_columns.Mismatch(m_column);
+	}
+	bool onStartObject() override
+	{
+		return BeginValue(objectKind);
+	}
+	bool onKey(const char* begin, const char* end) override
+	{
+		if (m_rowsDepth)
+		{
+			if (m_depth == m_rowsDepth + 1)
+				m_column = m_columns.FindColumn(begin, end);
+		}
+		else if (m_depth == m_frames.size() && !m_frames.empty())
+		{
+			const CJsonPath::token& t = m_tokens[m_frames.size() - 1];
+			m_frames.back().keyMatch = !t.indexOnly && t.key.size() == static_cast<size_t>(end - begin)
+				&& std::memcmp(t.key.data(), begin, t.key.size()) == 0;
+		}
+		return true;
+	}
+	bool onEndObject() override
+	{
+		return EndValue();
+	}
+	bool onStartArray() override
+	{
+		return BeginValue(arrayKind);
+	}
+	bool onEndArray() override
+	{
+		return EndValue();
+	}
+	//ǷѶ
+	bool IsDone() const { return m_done; }
+	//¼ǶʱĴ(ͲĴɸм¼)
+	const Json::String& GetErrorInfo() const { return m_errInfo; }
+private:
+	enum kind
+	{
+		scalarKind,
+		objectKind,
+		arrayKind
+	};
+	//·ѽ
+	struct frame
+	{
+		bool isArray;
+		Json::ArrayIndex index;
+		bool keyMatch;
+	};
+	//ǰֵǷΪ¼ѡеֶ
+	bool IsField() const
+	{
+		return m_rowsDepth && m_depth == m_rowsDepth + 1 && m_column >= 0;
+	}
+	//ǰֵǷ·һ
+	bool Matches() const
+	{
+		if (m_frames.empty())
+			return true;
+		const frame& f = m_frames.back();
+		if (!f.isArray)
+			return f.keyMatch;
+		const CJsonPath::token& t = m_tokens[m_frames.size() - 1];
+		return t.hasIndex && t.index == f.index;
+	}
+	bool BeginValue(kind k)
+	{
+		if (m_rowsDepth)
+		{
+			if (m_depth == m_rowsDepth)
+			{
+				//Ԫؼһ¼
+				if (k != objectKind)
+				{
+					m_errInfo = "Row " + std::to_string(m_columns.m_rowCount) + " is not an object";
+					return false;
+				}
+				m_columns.AddRow();
+				m_column = -1;
+			}
+			else if (k != scalarKind && IsField())
+				return m_columns.Mismatch(m_column);
+		}
+		else if (m_depth == m_frames.size())
+		{
+			bool match = Matches();
+			if (!m_frames.empty() && m_frames.back().isArray)
+				++m_frames.back().index;
+			if (match && m_frames.size() == m_tokens.size())
+			{
+				if (k != arrayKind)
+				{
+					m_errInfo = "Path is not an array";
+					return false;
+				}
+				m_rowsDepth = m_depth + 1;
+			}
+			else if (match && k != scalarKind)
+				m_frames.push_back(frame{ k == arrayKind, 0, false });
+		}
+		if (k != scalarKind)
+			++m_depth;
+		return true;
+	}
+	bool EndValue()
+	{
+		--m_depth;
+		if (m_rowsDepth && m_depth < m_rowsDepth)
+		{
+			//Ѷ,ֹͣ
+			m_done = true;
+			return false;
+		}
+		if (m_depth < m_frames.size())
+			m_frames.pop_back();
+		return true;
+	}
+	CJsonColumns& m_columns;
+	const std::vector<CJsonPath::token>& m_tokens;
+	std::vector<frame> m_frames;
+	//Ѵ򿪵
+	size_t m_depth = 0;
+	//ĿڲĲ(0Ϊδҵ)
+	size_t m_rowsDepth = 0;
+	//¼еǰӦ
+	int m_column = -1;
+	bool m_done = false;
+	Json::String m_errInfo;
+};
+
+size_t CJsonColumns::AddColumn(const Json::String& field, ColumnType type)
+{
+	column c;
+	c.field = field;
+	c.type = type;
+	m_columns.push_back(std::move(c));
+	//Ѷȡ,гȲһ
+	ClearRows();
+	return m_columns.size() - 1;
+}
+
+bool CJsonColumns::Read(const char* begin, const char* end, const CJsonPath& arrayPath)
+{
+	ClearRows();
+	m_errInfo.clear();
+	if (!arrayPath.IsValid())
+	{
+		m_errInfo = arrayPath.GetErrorInfo();
+		return false;
+	}
+	Reader reader(*this, arrayPath);
+	Json::CharReaderBuilder ReaderBuilder;
+	Json::String errs;
+	bool ok = Json::parseEvents(ReaderBuilder, begin, end, reader, &errs);
+	//ֹͣʱparseEventstrue
+	if (!m_errInfo.empty())
+		ok = false;
+	else if (!reader.GetErrorInfo().empty())
+	{
+		ok = false;
+		m_errInfo = reader.GetErrorInfo() + ": " + arrayPath.GetPath();
+	}
+	else if (!ok)
+		m_errInfo = errs;
+	else if (!reader.IsDone())
+	{
+		ok = false;
+		m_errInfo = "Array not found: " + arrayPath.GetPath();
+	}
+	if (!ok)
+		ClearRows();
+	return ok;
+}
+
+bool CJsonColumns::Read(const Json::String& jsonString, const CJsonPath& arrayPath)
+{
+	return Read(jsonString.data(), jsonString.data() + jsonString.size(), arrayPath);
+}
+
+bool CJsonColumns::ReadFile(const Json::String& jsonFile, const CJsonPath& arrayPath)
+{
+	CJsonFileMap file;
+	if (!file.Open(jsonFile))
+	{
+		ClearRows();
+		m_errInfo = "Failed to open file: " + jsonFile;
+		return false;
+	}
+	return Read(file.Begin(), file.End(), arrayPath);
+}
+
+bool CJsonColumns::ReadValue(const Json::Value& root, const CJsonPath& arrayPath)
+{
+	ClearRows();
+	m_errInfo.clear();
+	if (!arrayPath.IsValid())
+	{
+		m_errInfo = arrayPath.GetErrorInfo();
+		return false;
+	}
+	const Json::Value* array = arrayPath.Resolve(root);
+	if (!array)
+	{
+		m_errInfo = "Array not found: " + arrayPath.GetPath();
+		return false;
+	}
+	if (!array->isArray())
+	{
+		m_errInfo = "Path is not an array: " + arrayPath.GetPath();
+		return false;
+	}
+	for (Json::ArrayIndex i = 0; i < array->size(); ++i)
+	{
+		const Json::Value& record = (*array)[i];
+		if (!record.isObject())
+		{
+			m_errInfo = "Row " + std::to_string(i) + " is not an object: " + arrayPath.GetPath();
+			ClearRows();
+			return false;
+		}
+		AddRow();
+		for (size_t c = 0; c < m_columns.size(); ++c)
+		{
+			const Json::String& field = m_columns[c].field;
+			const Json::Value* v = record.find(field.data(), field.data() + field.size());
+			if (!v)
+				continue;
+			int index = static_cast<int>(c);
+			bool ok = true;
+			switch (v->type())
+			{
+			case Json::nullValue:
+				break;
+			case Json::intValue:
+				ok = PutInt(index, v->asLargestInt());
+				break;
+			case Json::uintValue:
+				ok = PutUInt(index, v->asLargestUInt());
+				break;
+			case Json::realValue:
+				ok = PutDouble(index, v->asDouble());
+				break;
+			case Json::stringValue:
+			{
+				const char* begin = nullptr;
+				const char* end = nullptr;
+				v->getString(&begin, &end);
+				ok = PutString(index, begin, end);
+				break;
+			}
+			default:
+				ok = false;
+				break;
+			}
+			if (!ok)
+			{
+				Mismatch(index);
+				ClearRows();
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+const std::vector<int64_t>& CJsonColumns::GetInt64(size_t column) const
+{
+	if (column >= m_columns.size() || m_columns[column].type != Int64Column)
+		return g_noInts;
+	return m_columns[column].ints;
+}
+
+const std::vector<double>& CJsonColumns::GetDouble(size_t column) const
+{
+	if (column >= m_columns.size() || m_columns[column].type != DoubleColumn)
+		return g_noDoubles;
+	return m_columns[column].doubles;
+}
+
+const std::vector<std::string_view>& CJsonColumns::GetString(size_t column) const
+{
+	if (column >= m_columns.size() || m_columns[column].type != StringColumn)
+		return g_noStrings;
+	return m_columns[column].strings;
+}
+
+const std::vector<uint8_t>& CJsonColumns::GetValid(size_t column) const
+{
+	if (column >= m_columns.size())
+		return g_noValid;
+	return m_columns[column].valid;
+}
+
+void CJsonColumns::ClearRows()
+{
+	for (column& c : m_columns)
+	{
+		c.ints.clear();
+		c.doubles.clear();
+		c.strings.clear();
+		c.valid.clear();
+	}
+	m_rowCount = 0;
+	m_strings.release();
+}
+
+void CJsonColumns::AddRow()
+{
+	for (column& c : m_columns)
+	{
+		switch (c.type)
+		{
+		case Int64Column:
+			c.ints.push_back(0);
+			break;
+		case DoubleColumn:
+			c.doubles.push_back(std::numeric_limits<double>::quiet_NaN());
+			break;
+		case StringColumn:
+			c.strings.emplace_back();
+			break;
+		}
+		c.valid.push_back(0);
+	}
+	++m_rowCount;
+}
+
+int CJsonColumns::FindColumn(const char* begin, const char* end) const
+{
+	const size_t length = static_cast<size_t>(end - begin);
+	for (size_t i = 0; i < m_columns.size(); ++i)
+	{
+		const Json::String& field = m_columns[i].field;
+		if (field.size() == length && std::memcmp(field.data(), begin, length) == 0)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+bool CJsonColumns::PutInt(int index, Json::LargestInt value)
+{
+	column& c = m_columns[index];
+	if (c.type == Int64Column)
+		c.ints.back() = value;
+	else if (c.type == DoubleColumn)
+		c.doubles.back() = static_cast<double>(value);
+	else
+		return false;
+	c.valid.back() = 1;
+	return true;
+}
+
+bool CJsonColumns::PutUInt(int index, Json::LargestUInt value)
+{
+	column& c = m_columns[index];
+	if (c.type == Int64Column && value <= static_cast<Json::LargestUInt>(std::numeric_limits<int64_t>::max()))
+		c.ints.back() = static_cast<int64_t>(value);
+	else if (c.type == DoubleColumn)
+		c.doubles.back() = static_cast<double>(value);
+	else
+		return false;
+	c.valid.back() = 1;
+	return true;
+}
+
+bool CJsonColumns::PutDouble(int index, double value)
+{
+	column& c = m_columns[index];
+	//ֻܷΧڵֵ
+	if (c.type == Int64Column && value >= -9223372036854775808.0
+		&& value < 9223372036854775808.0 && std::trunc(value) == value)
+		c.ints.back() = static_cast<int64_t>(value);
+	else if (c.type == DoubleColumn)
+		c.doubles.back() = value;
+	else
+		return false;
+	c.valid.back() = 1;
+	return true;
+}
+
+bool CJsonColumns::PutString(int index, const char* begin, const char* end)
+{
+	column& c = m_columns[index];
+	if (c.type != StringColumn)
+		return false;
+	const size_t length = static_cast<size_t>(end - begin);
+	if (length)
+	{
+		char* data = static_cast<char*>(m_strings.allocate(length, 1));
+		std::memcpy(data, begin, length);
+		c.strings.back() = std::string_view(data, length);
+	}
+	else
+		c.strings.back() = std::string_view();
+	c.valid.back() = 1;
+	return true;
+}
+
+bool CJsonColumns::Mismatch(int index)
+{
+	m_errInfo = "Value type does not match column '" + m_columns[index].field
+		+ "' at row " + std::to_string(m_rowCount - 1);
+	return false;
+}
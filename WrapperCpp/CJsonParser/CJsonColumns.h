@@ -0,0 +1,76 @@
+#ifndef CJSON_COLUMNS_H
+#define CJSON_COLUMNS_H
+
+#include "jsoncpp/json.h"
+#include "CJsonPath.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+//жȡ¼:һαѸ¼ֶָͻ(ı¼,ɼ¼)
+class CJsonColumns
+{
+public:
+	//(Ҳֵĸ,н)
+	enum ColumnType
+	{
+		Int64Column,
+		DoubleColumn,
+		StringColumn
+	};
+	CJsonColumns() = default;
+	CJsonColumns(const CJsonColumns&) = delete;
+	CJsonColumns& operator=(const CJsonColumns&) = delete;
+	//,(fieldΪ¼ĳԱ)
+	size_t AddColumn(const Json::String& field, ColumnType type);
+	//
+	size_t GetColumnCount() const { return m_columns.size(); }
+	//ȡJsonıarrayPathļ¼(ֹͣ,ټ֮)
+	bool Read(const char* begin, const char* end, const CJsonPath& arrayPath);
+	bool Read(const Json::String& jsonString, const CJsonPath& arrayPath);
+	//ȡJsonļ(ڴӳ)
+	bool ReadFile(const Json::String& jsonFile, const CJsonPath& arrayPath);
+	//ȡѽ(Ƽ¼)
+	bool ReadValue(const Json::Value& root, const CJsonPath& arrayPath);
+	//¼(ÿζȡ,ʧʱΪ0)
+	size_t GetRowCount() const { return m_rowCount; }
+	//(Ͳؿ);ȱٻΪnullֶΪ0,ΪNaN,ַΪ
+	const std::vector<int64_t>& GetInt64(size_t column) const;
+	const std::vector<double>& GetDouble(size_t column) const;
+	//ַͼ´ζȡǰЧ
+	const std::vector<std::string_view>& GetString(size_t column) const;
+	//¼Ƿиֶεķnullֵ(1Ϊ)
+	const std::vector<uint8_t>& GetValid(size_t column) const;
+	//ôϢ
+	Json::String GetErrorInfo() const { return m_errInfo; }
+private:
+	class Reader;
+	struct column
+	{
+		Json::String field;
+		ColumnType type;
+		std::vector<int64_t> ints;
+		std::vector<double> doubles;
+		std::vector<std::string_view> strings;
+		std::vector<uint8_t> valid;
+	};
+	//ո(Ϣ)
+	void ClearRows();
+	//׷һȱʡֵ
+	void AddRow();
+	//Ա(ڷ-1)
+	int FindColumn(const char* begin, const char* end) const;
+	//뵱ǰеֶ,Ͳfalse
+	bool PutInt(int index, Json::LargestInt value);
+	bool PutUInt(int index, Json::LargestUInt value);
+	bool PutDouble(int index, double value);
+	bool PutString(int index, const char* begin, const char* end);
+	//¼Ͳλ,false
+	bool Mismatch(int index);
+	std::vector<column> m_columns;
+	size_t m_rowCount = 0;
+	//ַ,ÿζȡʱͷ
+	Json::Arena m_strings;
+	Json::String m_errInfo;
+};
+
+#endif	//CJSON_COLUMNS_H
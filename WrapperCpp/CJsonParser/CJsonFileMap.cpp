@@ -0,0 +1,120 @@
+#include "CJsonFileMap.h"
+
+#include <fstream>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+CJsonFileMap::~CJsonFileMap()
+{
+	Close();
+}
+
+bool CJsonFileMap::Open(const Json::String& fileName)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+		static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX)
+	{
+		CloseHandle(file);
+		return ReadFile(fileName);
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return ReadFile(fileName);
+	}
+	m_file = file;
+	m_mapping = mapping;
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+	{
+		//ļļ޷ӳ
+		close(fd);
+		return ReadFile(fileName);
+	}
+	void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	//ӳ佨ļɹر
+	close(fd);
+	if (view == MAP_FAILED)
+		return ReadFile(fileName);
+#ifdef MADV_SEQUENTIAL
+	madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<size_t>(st.st_size);
+#endif
+	m_mapped = true;
+	return true;
+}
+
+void CJsonFileMap::Close()
+{
+	if (m_mapped)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(static_cast<HANDLE>(m_mapping));
+		CloseHandle(static_cast<HANDLE>(m_file));
+		m_mapping = nullptr;
+		m_file = nullptr;
+#else
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+	}
+	m_buffer.clear();
+	m_buffer.shrink_to_fit();
+	m_data = nullptr;
+	m_size = 0;
+	m_mapped = false;
+}
+
+bool CJsonFileMap::ReadFile(const Json::String& fileName)
+{
+	std::ifstream ifile(fileName, std::ios::binary);
+	if (!ifile.is_open())
+		return false;
+	//ֱӶԤĻ,ֻһο
+	ifile.seekg(0, std::ios::end);
+	std::streamoff size = ifile.tellg();
+	ifile.seekg(0, std::ios::beg);
+	if (size > 0)
+	{
+		m_buffer.resize(static_cast<size_t>(size));
+		ifile.read(&m_buffer[0], size);
+		m_buffer.resize(static_cast<size_t>(ifile.gcount()));
+	}
+	else
+	{
+		//޷óȵȡ
+		char chunk[4096];
+		while (ifile.read(chunk, sizeof(chunk)) || ifile.gcount() > 0)
+			m_buffer.append(chunk, static_cast<size_t>(ifile.gcount()));
+	}
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+	return true;
+}
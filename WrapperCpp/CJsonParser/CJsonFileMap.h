@@ -0,0 +1,36 @@
+#ifndef CJSON_FILE_MAP_H
+#define CJSON_FILE_MAP_H
+
+#include "jsoncpp/json.h"
+//ֻļڴӳ(޷ӳļ˻ΪһԶ뻺)
+class CJsonFileMap
+{
+public:
+	CJsonFileMap() = default;
+	~CJsonFileMap();
+	CJsonFileMap(const CJsonFileMap&) = delete;
+	CJsonFileMap& operator=(const CJsonFileMap&) = delete;
+	//ļ
+	bool Open(const Json::String& fileName);
+	//رļ
+	void Close();
+	//ļݷΧ
+	const char* Begin() const { return m_data; }
+	const char* End() const { return m_data + m_size; }
+	size_t Size() const { return m_size; }
+	//Ƿͨڴӳ(falseʾ˻)
+	bool IsMapped() const { return m_mapped; }
+private:
+	//ӳʧʱ뻺
+	bool ReadFile(const Json::String& fileName);
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_mapped = false;
+	Json::String m_buffer;
+#ifdef _WIN32
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
+
+#endif	//CJSON_FILE_MAP_H
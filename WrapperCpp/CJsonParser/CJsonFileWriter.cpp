@@ -0,0 +1,192 @@
+#include "CJsonFileWriter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace
+{
+	//ʱļʧʱԴ
+	const int kMaxTempAttempts = 100;
+	std::atomic<unsigned> g_tempCounter(0);
+
+	//ͬĿ¼µʱļ(̺ͬʱͬһļĶд)
+	Json::String TempName(const Json::String& fileName)
+	{
+#ifdef _WIN32
+		unsigned long pid = GetCurrentProcessId();
+#else
+		unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+		return fileName + "." + std::to_string(pid) + "." + std::to_string(g_tempCounter++) + ".tmp";
+	}
+}
+
+CJsonFileWriter::~CJsonFileWriter()
+{
+	Discard();
+}
+
+bool CJsonFileWriter::Open(const Json::String& fileName)
+{
+	Discard();
+	m_failed = false;
+	//ֻļ,Ѵڵͬļ;ʱļֻڴɹ¼,Discardɾ˵ļ
+	Json::String tempFile;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	for (int i = 0; i < kMaxTempAttempts && file == INVALID_HANDLE_VALUE; ++i)
+	{
+		tempFile = TempName(fileName);
+		file = CreateFileA(tempFile.c_str(), GENERIC_WRITE, 0, nullptr,
+			CREATE_NEW, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE && GetLastError() != ERROR_FILE_EXISTS)
+			return false;
+	}
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	m_file = file;
+#else
+	//ʱļԭļȨ(mkstemp,0600Ȩ޻ı½ļȨ)
+	mode_t mode = 0666;
+	struct stat st;
+	if (stat(fileName.c_str(), &st) == 0)
+		mode = st.st_mode & 07777;
+	int fd = -1;
+	for (int i = 0; i < kMaxTempAttempts && fd < 0; ++i)
+	{
+		tempFile = TempName(fileName);
+		fd = open(tempFile.c_str(), O_WRONLY | O_CREAT | O_EXCL, mode);
+		if (fd < 0 && errno != EEXIST)
+			return false;
+	}
+	if (fd < 0)
+		return false;
+	if (mode != 0666)
+		fchmod(fd, mode);
+	m_fd = fd;
+#endif
+	m_fileName = fileName;
+	m_tempFile = tempFile;
+	return true;
+}
+
+bool CJsonFileWriter::Write(const char* data, size_t size)
+{
+	if (m_failed)
+		return false;
+#ifdef _WIN32
+	if (!m_file)
+		return false;
+	while (size > 0)
+	{
+		DWORD part = static_cast<DWORD>(size > 0x40000000 ? 0x40000000 : size);
+		DWORD written = 0;
+		if (!WriteFile(static_cast<HANDLE>(m_file), data, part, &written, nullptr))
+		{
+			m_failed = true;
+			return false;
+		}
+		data += written;
+		size -= written;
+	}
+#else
+	if (m_fd < 0)
+		return false;
+	while (size > 0)
+	{
+		ssize_t written = write(m_fd, data, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			m_failed = true;
+			return false;
+		}
+		data += written;
+		size -= static_cast<size_t>(written);
+	}
+#endif
+	return true;
+}
+
+bool CJsonFileWriter::Commit(bool sync)
+{
+	if (!CloseTemp(sync) || m_failed)
+	{
+		Discard();
+		return false;
+	}
+#ifdef _WIN32
+	DWORD flags = MOVEFILE_REPLACE_EXISTING | (sync ? MOVEFILE_WRITE_THROUGH : 0);
+	if (!MoveFileExA(m_tempFile.c_str(), m_fileName.c_str(), flags))
+	{
+		Discard();
+		return false;
+	}
+#else
+	if (rename(m_tempFile.c_str(), m_fileName.c_str()) != 0)
+	{
+		Discard();
+		return false;
+	}
+	//¼Ŀ¼,ͬĿ¼Ųϵ綪ʧ
+	if (sync)
+	{
+		Json::String::size_type slash = m_fileName.find_last_of('/');
+		Json::String dir = slash == Json::String::npos ? Json::String(".")
+			: slash == 0 ? Json::String("/") : m_fileName.substr(0, slash);
+		int dirfd = open(dir.c_str(), O_RDONLY);
+		if (dirfd >= 0)
+		{
+			fsync(dirfd);
+			close(dirfd);
+		}
+	}
+#endif
+	m_tempFile.clear();
+	m_fileName.clear();
+	return true;
+}
+
+void CJsonFileWriter::Discard()
+{
+	CloseTemp(false);
+	if (!m_tempFile.empty())
+		std::remove(m_tempFile.c_str());
+	m_tempFile.clear();
+	m_fileName.clear();
+}
+
+bool CJsonFileWriter::CloseTemp(bool sync)
+{
+	bool ok = true;
+#ifdef _WIN32
+	if (!m_file)
+		return false;
+	if (sync && !FlushFileBuffers(static_cast<HANDLE>(m_file)))
+		ok = false;
+	if (!CloseHandle(static_cast<HANDLE>(m_file)))
+		ok = false;
+	m_file = nullptr;
+#else
+	if (m_fd < 0)
+		return false;
+	if (sync && fsync(m_fd) != 0)
+		ok = false;
+	if (close(m_fd) != 0)
+		ok = false;
+	m_fd = -1;
+#endif
+	return ok;
+}
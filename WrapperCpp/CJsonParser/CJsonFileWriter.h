@@ -0,0 +1,37 @@
+#ifndef CJSON_FILE_WRITER_H
+#define CJSON_FILE_WRITER_H
+
+#include "jsoncpp/json.h"
+//ԭļд(дͬĿ¼ʱļ,ύʱĿļ,;ʧܻƻԭļ)
+class CJsonFileWriter
+{
+public:
+	CJsonFileWriter() = default;
+	//δύʱļʱɾ
+	~CJsonFileWriter();
+	CJsonFileWriter(const CJsonFileWriter&) = delete;
+	CJsonFileWriter& operator=(const CJsonFileWriter&) = delete;
+	//ĿļĿ¼Ψһʱļ
+	bool Open(const Json::String& fileName);
+	//д(ֱдļ,߸ɿд)
+	bool Write(const char* data, size_t size);
+	//رʱļĿļ(syncΪtrueʱȰˢ)
+	bool Commit(bool sync = false);
+	//д,ɾ󴴽ʱļ
+	void Discard();
+	//ʱļ
+	const Json::String& GetTempFile() const { return m_tempFile; }
+private:
+	//رʱļ
+	bool CloseTemp(bool sync);
+	Json::String m_fileName;
+	Json::String m_tempFile;
+	bool m_failed = false;
+#ifdef _WIN32
+	void* m_file = nullptr;
+#else
+	int m_fd = -1;
+#endif
+};
+
+#endif	//CJSON_FILE_WRITER_H
@@ -0,0 +1,361 @@
+#include "CJsonJournal.h"
+#include "CJsonFileMap.h"
+#include "CJsonPatch.h"
+#include "CJsonPath.h"
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+namespace
+{
+	//ɸļJSON Pointer
+	Json::String MakePointer(const std::vector<Json::String>& keys, size_t count)
+	{
+		Json::String pointer;
+		for (size_t i = 0; i < count; ++i)
+			pointer += "/" + CJsonPatch::EscapeKey(keys[i]);
+		return pointer;
+	}
+
+	//ؼ¼·ǰcountԱ(¼·ֻ)
+	//createΪtrueʱȱٵĳԱ,·ϲǶĽڵ滻Ϊ:
+	//־ڸµĿط,м״̬ճͻʱ֮ļ¼ָΪֵ
+	Json::Value* WalkObjects(Json::Value& root, const CJsonPath& path, size_t count, bool create)
+	{
+		Json::Value* v = &root;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Json::String& key = path.GetKey(i);
+			if (!v->isObject())
+			{
+				if (!create)
+					return nullptr;
+				*v = Json::Value(Json::objectValue);
+			}
+			Json::Value* child = create ? v->demand(key.data(), key.data() + key.size())
+				: const_cast<Json::Value*>(v->find(key.data(), key.data() + key.size()));
+			if (!child)
+				return nullptr;
+			v = child;
+		}
+		return v;
+	}
+
+	bool FileExists(const Json::String& file)
+	{
+		std::error_code ec;
+		return std::filesystem::exists(file, ec);
+	}
+
+	//ļˢ
+	bool SyncFile(std::FILE* file)
+	{
+#ifdef _WIN32
+		return _commit(_fileno(file)) == 0;
+#else
+		return fsync(fileno(file)) == 0;
+#endif
+	}
+}
+
+CJsonJournal::CJsonJournal()
+	: m_writer("", false)
+{
+}
+
+CJsonJournal::~CJsonJournal()
+{
+	Close();
+}
+
+bool CJsonJournal::Open(const Json::String& file, Json::Value& root, size_t compactSize, bool sync)
+{
+	Close();
+	m_errInfo.clear();
+	m_snapshotFile = file;
+	m_journalFile = file + ".journal";
+	m_oldJournalFile = file + ".journal.old";
+	m_compactSize = compactSize;
+	m_sync = sync;
+	m_compactOk = true;
+	//ؿ(ʱӿնʼ,ڵ޷ȡʱʧ,ܵĵ)
+	Json::Value doc(Json::objectValue);
+	CJsonFileMap snapshot;
+	if (!snapshot.Open(file))
+	{
+		if (FileExists(file))
+		{
+			m_errInfo = "Failed to open snapshot: " + file;
+			return false;
+		}
+	}
+	else if (snapshot.Size() > 0)
+	{
+		Json::CharReaderBuilder ReaderBuilder;
+		ReaderBuilder["trackOffsets"] = false;
+		std::unique_ptr<Json::CharReader> charread(ReaderBuilder.newCharReader());
+		if (!charread->parse(snapshot.Begin(), snapshot.End(), &doc, &m_errInfo))
+			return false;
+	}
+	snapshot.Close();
+	//ϴѹûʱ־,طž־
+	if (!ReplayFile(m_oldJournalFile, doc, false) || !ReplayFile(m_journalFile, doc, true))
+		return false;
+	m_file = std::fopen(m_journalFile.c_str(), "ab");
+	if (!m_file)
+	{
+		m_errInfo = "Failed to open journal: " + m_journalFile;
+		return false;
+	}
+	std::fseek(m_file, 0, SEEK_END);
+	long size = std::ftell(m_file);
+	m_journalSize = size > 0 ? static_cast<size_t>(size) : 0;
+	root.swap(doc);
+	return true;
+}
+
+void CJsonJournal::Close()
+{
+	WaitCompaction();
+	if (m_file)
+	{
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+	m_journalSize = 0;
+}
+
+bool CJsonJournal::ReplayFile(const Json::String& file, Json::Value& root, bool truncateTail)
+{
+	//־ʱûҪطŵļ¼,ڵ޷ȡʱʧ
+	CJsonFileMap map;
+	if (!map.Open(file))
+	{
+		if (!FileExists(file))
+			return true;
+		m_errInfo = "Failed to open journal: " + file;
+		return false;
+	}
+	Json::CharReaderBuilder ReaderBuilder;
+	ReaderBuilder["failIfExtra"] = true;
+	ReaderBuilder["trackOffsets"] = false;
+	std::unique_ptr<Json::CharReader> charread(ReaderBuilder.newCharReader());
+	const char* p = map.Begin();
+	const char* end = map.End();
+	size_t lineNumber = 0;
+	while (p != end)
+	{
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+		//һ¼ûд(дʱ),
+		if (!eol)
+			break;
+		++lineNumber;
+		if (eol != p)
+		{
+			Json::Value record;
+			Json::String err;
+			if (!charread->parse(p, eol, &record, &err) || !Replay(root, record, &err))
+			{
+				m_errInfo = "Bad journal record at " + file + ":" + std::to_string(lineNumber) + ": " + err;
+				return false;
+			}
+		}
+		p = eol + 1;
+	}
+	size_t complete = static_cast<size_t>(p - map.Begin());
+	size_t size = map.Size();
+	map.Close();
+	//صļ¼,֮׷Ӵпʼ
+	if (truncateTail && complete < size)
+	{
+		std::error_code ec;
+		std::filesystem::resize_file(file, complete, ec);
+		if (ec)
+		{
+			m_errInfo = "Failed to truncate journal: " + file;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool CJsonJournal::Replay(Json::Value& root, const Json::Value& record, Json::String* err)
+{
+	Json::String message;
+	const Json::Value* pointer = nullptr;
+	const char* type = nullptr;
+	if (record.isObject())
+	{
+		for (const char* name : { "set", "unset", "merge" })
+		{
+			pointer = record.find(name, name + strlen(name));
+			if (pointer)
+			{
+				type = name;
+				break;
+			}
+		}
+	}
+	const Json::Value* value = record.isObject() ? record.find("value", "value" + 5) : nullptr;
+	CJsonPath path;
+	if (!pointer || !pointer->isString() || (type[0] != 'u' && !value))
+		message = "unknown journal record";
+	else if (!pointer->asString().empty() && pointer->asString()[0] != '/')
+		message = "not a JSON Pointer: " + pointer->asString();
+	else if (!path.Compile(pointer->asString()))
+		message = path.GetErrorInfo();
+	else if (type[0] == 'u')
+	{
+		//ɾԱ,ԱʱʲôҲ
+		Json::Value* parent = path.Size() > 0 ? WalkObjects(root, path, path.Size() - 1, false) : nullptr;
+		if (parent && parent->isObject())
+			parent->removeMember(path.LastKey().data(), path.LastKey().data() + path.LastKey().size(), nullptr);
+	}
+	else
+	{
+		Json::Value* target = WalkObjects(root, path, path.Size(), true);
+		if (type[0] == 's')
+			*target = *value;
+		else
+			CJsonPatch::ApplyMerge(*target, *value);
+	}
+	if (err)
+		*err = message;
+	return message.empty();
+}
+
+bool CJsonJournal::LogLocation(const Json::Value& root, const std::vector<Json::String>& keys)
+{
+	//·ҵҪ¼Ľڵ:ֵʱ¼ڵ,Աʱ¼ɾ
+	const Json::Value* v = &root;
+	size_t depth = 0;
+	for (; depth < keys.size(); ++depth)
+	{
+		if (!v->isObject())
+			break;
+		const Json::String& key = keys[depth];
+		const Json::Value* child = v->find(key.data(), key.data() + key.size());
+		if (!child)
+		{
+			m_line = "{\"unset\":";
+			m_writer.Write(Json::Value(MakePointer(keys, depth + 1)), m_line);
+			m_line += "}\n";
+			return Append();
+		}
+		v = child;
+	}
+	//ֱлڵ,
+	m_line = "{\"set\":";
+	m_writer.Write(Json::Value(MakePointer(keys, depth)), m_line);
+	m_line += ",\"value\":";
+	m_writer.Write(*v, m_line);
+	m_line += "}\n";
+	return Append();
+}
+
+bool CJsonJournal::LogMerge(const std::vector<Json::String>& keys, const Json::Value& patch)
+{
+	m_line = "{\"merge\":";
+	m_writer.Write(Json::Value(MakePointer(keys, keys.size())), m_line);
+	m_line += ",\"value\":";
+	m_writer.Write(patch, m_line);
+	m_line += "}\n";
+	return Append();
+}
+
+bool CJsonJournal::Append()
+{
+	if (!m_file)
+		return false;
+	//һ¼һд벢ˢ,ʱһļ¼
+	bool ok = std::fwrite(m_line.data(), 1, m_line.size(), m_file) == m_line.size()
+		&& std::fflush(m_file) == 0 && (!m_sync || SyncFile(m_file));
+	if (!ok)
+	{
+		m_errInfo = "Failed to write journal: " + m_journalFile;
+		return false;
+	}
+	m_journalSize += m_line.size();
+	return true;
+}
+
+void CJsonJournal::CompactIfNeeded(const Json::Value& root)
+{
+	if (m_compactSize > 0 && m_journalSize >= m_compactSize && !m_compacting)
+		Compact(root, false);
+}
+
+bool CJsonJournal::Compact(const Json::Value& root, bool wait)
+{
+	if (!m_file)
+		return false;
+	WaitCompaction();
+	//ĵֻ־ͬʱ,ð־еȫ޸
+	Json::Value snapshot(root);
+	if (!RotateJournal())
+		return false;
+	m_compacting = true;
+	m_compactor = std::thread([this](Json::Value doc)
+	{
+		CJsonWriter writer("");
+		bool ok = writer.WriteFile(doc, m_snapshotFile, m_sync);
+		//ձɹ־ſɾ
+		if (ok)
+			std::remove(m_oldJournalFile.c_str());
+		m_compactOk = ok;
+		m_compacting = false;
+	}, std::move(snapshot));
+	if (wait)
+		return WaitCompaction();
+	return true;
+}
+
+bool CJsonJournal::WaitCompaction()
+{
+	if (m_compactor.joinable())
+		m_compactor.join();
+	return m_compactOk;
+}
+
+bool CJsonJournal::RotateJournal()
+{
+	std::fclose(m_file);
+	m_file = nullptr;
+	bool ok = true;
+	if (FileExists(m_oldJournalFile))
+	{
+		//ϴѹʧ,־:ѵǰ־ӵ־
+		CJsonFileMap journal;
+		std::FILE* old = std::fopen(m_oldJournalFile.c_str(), "ab");
+		ok = old != nullptr;
+		if (ok && journal.Open(m_journalFile) && journal.Size() > 0)
+			ok = std::fwrite(journal.Begin(), 1, journal.Size(), old) == journal.Size();
+		if (old)
+			ok = std::fflush(old) == 0 && (!m_sync || SyncFile(old)) && ok;
+		if (old)
+			std::fclose(old);
+		journal.Close();
+		ok = ok && std::remove(m_journalFile.c_str()) == 0;
+	}
+	else
+		ok = std::rename(m_journalFile.c_str(), m_oldJournalFile.c_str()) == 0;
+	//ֻǷɹ´־,֮޸ļ¼
+	m_file = std::fopen(m_journalFile.c_str(), "ab");
+	if (m_file)
+	{
+		std::fseek(m_file, 0, SEEK_END);
+		long size = std::ftell(m_file);
+		m_journalSize = size > 0 ? static_cast<size_t>(size) : 0;
+	}
+	if (!ok || !m_file)
+	{
+		m_errInfo = "Failed to rotate journal: " + m_journalFile;
+		return false;
+	}
+	return true;
+}
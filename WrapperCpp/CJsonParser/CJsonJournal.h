@@ -0,0 +1,66 @@
+#ifndef CJSON_JOURNAL_H
+#define CJSON_JOURNAL_H
+
+#include "jsoncpp/json.h"
+#include "CJsonWriter.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+//Jsonĵ޸־,ÿ޸׷һм¼(NDJSON),ʱڿط,־ʱ̨ѹΪ¿
+//¼޸ĺλõֵ(¼),ظطŽ
+class CJsonJournal
+{
+public:
+	CJsonJournal();
+	//ȴ̨ѹɲر־
+	~CJsonJournal();
+	CJsonJournal(const CJsonJournal&) = delete;
+	CJsonJournal& operator=(const CJsonJournal&) = delete;
+	//ؿļط־(file.journal.oldfile.journal),ղʱӿնʼ,
+	//ջ־ڵ޷ȡʱʧ
+	//compactSizeΪ־ѹֵ,syncΪtrueʱÿ¼ˢ
+	bool Open(const Json::String& file, Json::Value& root,
+		size_t compactSize = 4 << 20, bool sync = false);
+	//ر־(ȴ̨ѹ)
+	void Close();
+	bool IsOpen() const { return m_file != nullptr; }
+	//¼rootkeysָλ޸ĺֵ(λòʱ¼ɾ)
+	bool LogLocation(const Json::Value& root, const std::vector<Json::String>& keys);
+	//¼keysָӦõMerge Patch
+	bool LogMerge(const std::vector<Json::String>& keys, const Json::Value& patch);
+	//־ֵʱʼ̨ѹ(rootΪǰĵ,ƺں̨)
+	void CompactIfNeeded(const Json::Value& root);
+	//ѵǰĵΪ¿ղ־(waitΪfalseʱں̨)
+	bool Compact(const Json::Value& root, bool wait = false);
+	//ȴ̨ѹ,һѹǷɹ
+	bool WaitCompaction();
+	//ǰ־С
+	size_t GetJournalSize() const { return m_journalSize; }
+	//ĵطһ¼(·ϲǶĽڵ滻Ϊ,־ڸµĿطҲʧ)
+	static bool Replay(Json::Value& root, const Json::Value& record, Json::String* err = nullptr);
+	//ôϢ
+	Json::String GetErrorInfo() const { return m_errInfo; }
+private:
+	//طһ־ļ(ĩβļ¼ص)
+	bool ReplayFile(const Json::String& file, Json::Value& root, bool truncateTail);
+	//дm_lineеһ¼
+	bool Append();
+	//ѵǰ־Ϊ־(־Ѵʱ׷ӵ־ĩβ)
+	bool RotateJournal();
+	Json::String m_snapshotFile;
+	Json::String m_journalFile;
+	Json::String m_oldJournalFile;
+	std::FILE* m_file = nullptr;
+	size_t m_journalSize = 0;
+	size_t m_compactSize = 0;
+	bool m_sync = false;
+	CJsonWriter m_writer;
+	Json::String m_line;
+	std::thread m_compactor;
+	std::atomic<bool> m_compacting{ false };
+	bool m_compactOk = true;
+	Json::String m_errInfo;
+};
+
+#endif	//CJSON_JOURNAL_H
@@ -0,0 +1,392 @@
+#include "CJsonLazyParser.h"
+
+#include <charconv>
+#include <cstring>
+namespace
+{
+	inline bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+	inline const char* SkipSpaces(const char* p, const char* end)
+	{
+		while (p != end && IsSpace(*p))
+			++p;
+		return p;
+	}
+	//ֵ(,true,false,null)Ľλ(ŻҲ,ɵ߱)
+	inline const char* SkipScalar(const char* p, const char* end)
+	{
+		while (p != end && *p != ',' && *p != '}' && *p != ']' && *p != '"'
+			&& *p != '{' && *p != '[' && !IsSpace(*p))
+			++p;
+		return p;
+	}
+	//ʱҪַ
+	struct StructuralTable
+	{
+		bool marks[256] = {};
+		StructuralTable()
+		{
+			for (unsigned char c : { '"', '{', '}', '[', ']', '/' })
+				marks[c] = true;
+		}
+	};
+	const StructuralTable g_structural;
+}
+
+CJsonLazyParser::CJsonLazyParser()
+{
+	Json::CharReaderBuilder ReaderBuilder;
+	ReaderBuilder["collectComments"] = false;
+	ReaderBuilder["trackOffsets"] = false;
+	m_reader.reset(ReaderBuilder.newCharReader());
+}
+
+CJsonLazyParser::~CJsonLazyParser() = default;
+
+void CJsonLazyParser::Reset()
+{
+	m_file.Close();
+	m_text.clear();
+	m_begin = m_end = nullptr;
+	m_entries.clear();
+	m_nodes.clear();
+}
+
+bool CJsonLazyParser::OpenFile(const Json::String& jsonFile)
+{
+	Reset();
+	if (!m_file.Open(jsonFile))
+	{
+		m_errInfo = "Failed to open file: " + jsonFile;
+		return false;
+	}
+	m_begin = m_file.Begin();
+	m_end = m_file.End();
+	if (!BuildIndex())
+	{
+		Reset();
+		return false;
+	}
+	m_nodes.push_back(node{ jsonFile, m_entries.empty() ? npos : 0 });
+	return true;
+}
+
+bool CJsonLazyParser::OpenString(const Json::String& jsonString)
+{
+	Reset();
+	m_text = jsonString;
+	m_begin = m_text.data();
+	m_end = m_begin + m_text.size();
+	if (!BuildIndex())
+	{
+		Reset();
+		return false;
+	}
+	m_nodes.push_back(node{ "", m_entries.empty() ? npos : 0 });
+	return true;
+}
+
+bool CJsonLazyParser::BuildIndex()
+{
+	m_errInfo.clear();
+	if (static_cast<size_t>(m_end - m_begin) >= npos)
+	{
+		m_errInfo = "Document is too large";
+		return false;
+	}
+	const char* root = SkipSpaces(m_begin, m_end);
+	if (root == m_end)
+	{
+		m_errInfo = "Empty document";
+		return false;
+	}
+	//ֻ¼ַ,ڶȡʱɨ
+	std::vector<uint32_t> open;
+	m_entries.reserve(static_cast<size_t>(m_end - m_begin) / 8);
+	const char* p = root;
+	while (p != m_end)
+	{
+		if (!g_structural.marks[static_cast<unsigned char>(*p)])
+		{
+			++p;
+			continue;
+		}
+		const uint32_t offset = static_cast<uint32_t>(p - m_begin);
+		switch (*p)
+		{
+		case '"':
+		{
+			//ҵǰ治бܵ
+			const char* q = p + 1;
+			while (true)
+			{
+				q = static_cast<const char*>(std::memchr(q, '"', static_cast<size_t>(m_end - q)));
+				if (!q)
+				{
+					m_errInfo = "Missing '\"' at offset " + std::to_string(offset);
+					return false;
+				}
+				const char* s = q;
+				while (s != p + 1 && s[-1] == '\\')
+					--s;
+				if (((q - s) & 1) == 0)
+					break;
+				++q;
+			}
+			uint32_t index = static_cast<uint32_t>(m_entries.size());
+			m_entries.push_back(entry{ offset, static_cast<uint32_t>(q - m_begin), index + 1 });
+			p = q + 1;
+			break;
+		}
+		case '{':
+		case '[':
+			open.push_back(static_cast<uint32_t>(m_entries.size()));
+			m_entries.push_back(entry{ offset, 0, 0 });
+			++p;
+			break;
+		case '}':
+		case ']':
+		{
+			char expected = *p == '}' ? '{' : '[';
+			if (open.empty() || m_begin[m_entries[open.back()].begin] != expected)
+			{
+				m_errInfo = Json::String("Unexpected '") + *p + "' at offset " + std::to_string(offset);
+				return false;
+			}
+			entry& e = m_entries[open.back()];
+			e.end = offset;
+			e.next = static_cast<uint32_t>(m_entries.size());
+			open.pop_back();
+			++p;
+			break;
+		}
+		default:
+			m_errInfo = "Comments are not supported at offset " + std::to_string(offset);
+			return false;
+		}
+		//ڵֻ֮հ
+		if (open.empty() && !m_entries.empty() && m_begin + m_entries[0].begin == root)
+		{
+			if (SkipSpaces(p, m_end) != m_end)
+			{
+				m_errInfo = "Extra data after offset " + std::to_string(p - m_begin);
+				return false;
+			}
+			break;
+		}
+	}
+	if (!open.empty())
+	{
+		m_errInfo = "Missing closing bracket";
+		return false;
+	}
+	//ڵΪʱûпɽĽڵ
+	if (!m_entries.empty() && m_begin + m_entries[0].begin != root)
+		m_entries.clear();
+	return true;
+}
+
+bool CJsonLazyParser::FindMember(uint32_t objEntry, std::string_view key, slot& value) const
+{
+	if (objEntry == npos || m_begin[m_entries[objEntry].begin] != '{')
+		return false;
+	const entry& obj = m_entries[objEntry];
+	const char* end = m_begin + obj.end;
+	const char* p = m_begin + obj.begin + 1;
+	uint32_t child = objEntry + 1;
+	//ظļjsoncppһȡһ
+	bool found = false;
+	while (true)
+	{
+		p = SkipSpaces(p, end);
+		if (p == end || *p != '"' || child >= m_entries.size())
+			return found;
+		//Ϊַ
+		const entry& k = m_entries[child];
+		const char* keyBegin = m_begin + k.begin + 1;
+		const char* keyEnd = m_begin + k.end;
+		child = k.next;
+		bool match = false;
+		if (std::memchr(keyBegin, '\\', static_cast<size_t>(keyEnd - keyBegin)) == nullptr)
+			match = key == std::string_view(keyBegin, static_cast<size_t>(keyEnd - keyBegin));
+		else
+		{
+			//תļȽ
+			Json::Value v;
+			Json::String err;
+			match = m_reader->parse(keyBegin - 1, keyEnd + 1, &v, &err) && v.isString()
+				&& key == std::string_view(v.asString());
+		}
+		p = SkipSpaces(keyEnd + 1, end);
+		if (p == end || *p != ':')
+			return found;
+		p = SkipSpaces(p + 1, end);
+		if (p == end)
+			return found;
+		slot v{ p, nullptr, npos };
+		if (*p == '"' || *p == '{' || *p == '[')
+		{
+			if (child >= m_entries.size())
+				return found;
+			const entry& e = m_entries[child];
+			v.entry = child;
+			v.end = m_begin + e.end + 1;
+			child = e.next;
+		}
+		else
+			v.end = SkipScalar(p, end);
+		if (match)
+		{
+			value = v;
+			found = true;
+		}
+		p = SkipSpaces(v.end, end);
+		if (p == end || *p != ',')
+			return found;
+		++p;
+	}
+}
+
+bool CJsonLazyParser::FindCurrent(const Json::String& key, slot& value) const
+{
+	if (m_nodes.size() == 0)
+		return false;
+	return FindMember(m_nodes.rbegin()->entry, key, value);
+}
+
+bool CJsonLazyParser::IsNull(const slot& value)
+{
+	return value.end - value.begin == 4 && std::memcmp(value.begin, "null", 4) == 0;
+}
+
+bool CJsonLazyParser::Materialize(const slot& value, Json::Value& result)
+{
+	return m_reader->parse(value.begin, value.end, &result, &m_errInfo);
+}
+
+bool CJsonLazyParser::Into(const Json::String& key)
+{
+	slot v;
+	if (!FindCurrent(key, v) || *v.begin != '{')
+		return false;
+	m_nodes.push_back(node{ key, v.entry });
+	return true;
+}
+
+void CJsonLazyParser::Outof()
+{
+	if (m_nodes.size() <= 1)
+		return;
+	m_nodes.pop_back();
+}
+
+Json::String CJsonLazyParser::GetErrorInfo()
+{
+	return m_errInfo;
+}
+
+bool CJsonLazyParser::HasMember(const Json::String& key)
+{
+	slot v;
+	return m_nodes.size() != 0 && FindMember(m_nodes.rbegin()->entry, key, v);
+}
+
+Json::Value CJsonLazyParser::GetCurrent()
+{
+	Json::Value result;
+	if (m_nodes.size() == 0)
+		return result;
+	uint32_t index = m_nodes.rbegin()->entry;
+	if (index == npos)
+	{
+		//ڵΪ
+		Materialize(slot{ m_begin, m_end, npos }, result);
+		return result;
+	}
+	const entry& e = m_entries[index];
+	Materialize(slot{ m_begin + e.begin, m_begin + e.end + 1, index }, result);
+	return result;
+}
+//////////////////////////////////////////////////////////////////////////
+Json::Value CJsonLazyParser::GetValue(const Json::String& key, Json::Value defaultValue)
+{
+	slot v;
+	Json::Value result;
+	if (!FindCurrent(key, v) || !Materialize(v, result))
+		return defaultValue;
+	return result;
+}
+
+bool CJsonLazyParser::GetBool(const Json::String& key, bool defaultValue)
+{
+	slot v;
+	if (!FindCurrent(key, v) || IsNull(v))
+		return defaultValue;
+	std::string_view token(v.begin, static_cast<size_t>(v.end - v.begin));
+	if (token == "true")
+		return true;
+	if (token == "false")
+		return false;
+	Json::Value result;
+	if (!Materialize(v, result))
+		return defaultValue;
+	return result.asBool();
+}
+
+int CJsonLazyParser::GetInt(const Json::String& key, int defaultValue)
+{
+	slot v;
+	if (!FindCurrent(key, v) || IsNull(v))
+		return defaultValue;
+	//ֱת,ʽjsoncppԭת
+	int value = 0;
+	std::from_chars_result r = std::from_chars(v.begin, v.end, value);
+	if (r.ec == std::errc() && r.ptr == v.end)
+		return value;
+	Json::Value result;
+	if (!Materialize(v, result))
+		return defaultValue;
+	return result.asInt();
+}
+
+double CJsonLazyParser::GetDouble(const Json::String& key, double defaultValue)
+{
+	slot v;
+	if (!FindCurrent(key, v) || IsNull(v))
+		return defaultValue;
+#if defined(__cpp_lib_to_chars)
+	double value = 0;
+	std::from_chars_result r = std::from_chars(v.begin, v.end, value);
+	if (r.ec == std::errc() && r.ptr == v.end)
+		return value;
+#endif
+	Json::Value result;
+	if (!Materialize(v, result))
+		return defaultValue;
+	return result.asDouble();
+}
+
+Json::String CJsonLazyParser::GetString(const Json::String& key, Json::String defaultValue)
+{
+	slot v;
+	if (!FindCurrent(key, v) || IsNull(v))
+		return defaultValue;
+	//ûתֱַַӸ
+	if (*v.begin == '"' && std::memchr(v.begin, '\\', static_cast<size_t>(v.end - v.begin)) == nullptr)
+		return Json::String(v.begin + 1, v.end - 1);
+	Json::Value result;
+	if (!Materialize(v, result))
+		return defaultValue;
+	return result.asCString();
+}
+
+Json::Value CJsonLazyParser::GetArray(const Json::String& key, Json::Value defaultValue)
+{
+	slot v;
+	Json::Value result;
+	if (!FindCurrent(key, v) || *v.begin != '[' || !Materialize(v, result))
+		return defaultValue;
+	return result;
+}
@@ -0,0 +1,82 @@
+#ifndef CJSON_LAZY_PARSER_H
+#define CJSON_LAZY_PARSER_H
+
+#include "jsoncpp/json.h"
+#include "CJsonFileMap.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string_view>
+#include <vector>
+//ֻJsonĵ,ʱַֻλ,ȡʱŽ(֧ע,ĵ4GB)
+class CJsonLazyParser
+{
+public:
+	CJsonLazyParser();
+	~CJsonLazyParser();
+	CJsonLazyParser(const CJsonLazyParser&) = delete;
+	CJsonLazyParser& operator=(const CJsonLazyParser&) = delete;
+	//Jsonļ(ڴӳ,ݲ)
+	bool OpenFile(const Json::String& jsonFile);
+	//Jsonַ(һ)
+	bool OpenString(const Json::String& jsonString);
+	//ڵ
+	bool Into(const Json::String& key);
+	//ؽڵ
+	void Outof();
+	//õǰڵ
+	bool GetBool(const Json::String& key, bool defaultValue = false);
+	int GetInt(const Json::String& key, int defaultValue = 0);
+	double GetDouble(const Json::String& key, double defaultValue = 0.0);
+	Json::String GetString(const Json::String& key, Json::String defaultValue = Json::String());
+	Json::Value GetArray(const Json::String& key, Json::Value defaultValue = Json::Value());
+	Json::Value GetValue(const Json::String& key, Json::Value defaultValue = Json::Value());
+	//ǰڵǷԱ
+	bool HasMember(const Json::String& key);
+	//ǰڵ
+	Json::Value GetCurrent();
+	//ôϢ
+	Json::String GetErrorInfo();
+private:
+	//ṹ(Ϊλ,ַΪλ,nextΪһ)
+	struct entry
+	{
+		uint32_t begin;
+		uint32_t end;
+		uint32_t next;
+	};
+	//һԱֵλ([begin,end)Χ,ַӦ)
+	struct slot
+	{
+		const char* begin;
+		const char* end;
+		uint32_t entry;
+	};
+	struct node
+	{
+		Json::String key;
+		uint32_t entry;
+	};
+	static const uint32_t npos = 0xFFFFFFFFu;
+	//ṹ
+	bool BuildIndex();
+	//ڶвҳԱ(ظļȡһ)
+	bool FindMember(uint32_t objEntry, std::string_view key, slot& value) const;
+	//ҵǰڵĳԱ(nullֵ)
+	bool FindCurrent(const Json::String& key, slot& value) const;
+	//ԱֵǷΪnull(͵ĻȡnullĬֵ)
+	static bool IsNull(const slot& value);
+	//һֵ
+	bool Materialize(const slot& value, Json::Value& result);
+	void Reset();
+	std::unique_ptr<Json::CharReader> m_reader;
+	CJsonFileMap m_file;
+	Json::String m_text;
+	const char* m_begin = nullptr;
+	const char* m_end = nullptr;
+	std::vector<entry> m_entries;
+	std::list<node> m_nodes;
+	Json::String m_errInfo;
+};
+
+#endif	//CJSON_LAZY_PARSER_H
@@ -0,0 +1,273 @@
+#include "CJsonLines.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+namespace
+{
+	//JSON LinesʹõĶȡ
+	Json::CharReader* NewLineReader()
+	{
+		Json::CharReaderBuilder ReaderBuilder;
+		ReaderBuilder["collectComments"] = false;
+		ReaderBuilder["failIfExtra"] = true;
+		ReaderBuilder["trackOffsets"] = false;
+		return ReaderBuilder.newCharReader();
+	}
+	//жǷΪ
+	bool IsBlankLine(const char* begin, const char* end)
+	{
+		for (; begin != end; ++begin)
+		{
+			if (*begin != ' ' && *begin != '\t' && *begin != '\r')
+				return false;
+		}
+		return true;
+	}
+}
+
+CJsonLinesReader::CJsonLinesReader()
+	: m_reader(NewLineReader())
+{
+}
+
+CJsonLinesReader::~CJsonLinesReader()
+{
+	Close();
+}
+
+bool CJsonLinesReader::OpenFile(const Json::String& jsonFile, size_t bufferSize)
+{
+	Close();
+	m_file.open(jsonFile, std::ios::binary);
+	if (!m_file.is_open())
+	{
+		m_errInfo = "Failed to open file: " + jsonFile;
+		return false;
+	}
+	m_bufferSize = std::max<size_t>(bufferSize, 4096);
+	m_buffer.resize(m_bufferSize);
+	m_cur = m_end = m_buffer.data();
+	m_eof = false;
+	return true;
+}
+
+bool CJsonLinesReader::OpenBuffer(const char* begin, const char* end)
+{
+	Close();
+	m_cur = begin;
+	m_end = end;
+	return true;
+}
+
+void CJsonLinesReader::Close()
+{
+	if (m_file.is_open())
+		m_file.close();
+	m_file.clear();
+	m_buffer.clear();
+	m_buffer.shrink_to_fit();
+	m_cur = m_end = nullptr;
+	m_eof = true;
+	m_lineNumber = 0;
+	m_errInfo.clear();
+}
+
+bool CJsonLinesReader::FillBuffer()
+{
+	if (m_eof)
+		return false;
+	//δƵͷ,һʱ󻺳
+	size_t remain = static_cast<size_t>(m_end - m_cur);
+	if (remain > 0 && m_cur != m_buffer.data())
+		memmove(m_buffer.data(), m_cur, remain);
+	if (remain == m_buffer.size())
+		m_buffer.resize(m_buffer.size() * 2);
+	m_file.read(m_buffer.data() + remain,
+		static_cast<std::streamsize>(m_buffer.size() - remain));
+	size_t count = static_cast<size_t>(m_file.gcount());
+	if (count == 0)
+		m_eof = true;
+	m_cur = m_buffer.data();
+	m_end = m_cur + remain + count;
+	return count > 0;
+}
+
+bool CJsonLinesReader::NextLine(const char*& begin, const char*& end)
+{
+	size_t searched = 0;
+	for (;;)
+	{
+		const char* from = m_cur + searched;
+		const char* lf = static_cast<const char*>(
+			memchr(from, '\n', static_cast<size_t>(m_end - from)));
+		if (lf)
+		{
+			begin = m_cur;
+			end = lf;
+			m_cur = lf + 1;
+			++m_lineNumber;
+			return true;
+		}
+		searched = static_cast<size_t>(m_end - m_cur);
+		if (!FillBuffer())
+		{
+			//һпûлз
+			if (m_cur == m_end)
+				return false;
+			begin = m_cur;
+			end = m_end;
+			m_cur = m_end;
+			++m_lineNumber;
+			return true;
+		}
+	}
+}
+
+bool CJsonLinesReader::ParseLine(Json::CharReader& reader, const char* begin,
+	const char* end, Json::Value& record, Json::String* err)
+{
+	if (end != begin && *(end - 1) == '\r')
+		--end;
+	return reader.parse(begin, end, &record, err);
+}
+
+bool CJsonLinesReader::Next(Json::Value& record)
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	while (NextLine(begin, end))
+	{
+		if (IsBlankLine(begin, end))
+			continue;
+		if (ParseLine(*m_reader, begin, end, record, &m_errInfo))
+			return true;
+		m_errInfo = "Line " + std::to_string(m_lineNumber) + ": " + m_errInfo;
+		return false;
+	}
+	return false;
+}
+
+bool CJsonLinesReader::ReadAll(const std::function<bool(Json::Value&)>& func,
+	unsigned threadCount, size_t batchSize)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	batchSize = std::max<size_t>(batchSize, 1);
+	//ÿ߳һȡ,ȡи
+	std::vector<std::unique_ptr<Json::CharReader>> readers;
+	for (unsigned i = 0; i < threadCount; ++i)
+		readers.emplace_back(NewLineReader());
+	size_t batchLines = batchSize * threadCount;
+	Json::String text;
+	std::vector<size_t> offsets;
+	std::vector<size_t> lineNumbers;
+	std::vector<Json::Value> records;
+	std::vector<Json::String> errors(threadCount);
+	std::vector<size_t> failed(threadCount);
+	for (;;)
+	{
+		//ռһ¼,ļᱻȿλ
+		text.clear();
+		offsets.assign(1, 0);
+		lineNumbers.clear();
+		const char* begin = nullptr;
+		const char* end = nullptr;
+		while (lineNumbers.size() < batchLines && NextLine(begin, end))
+		{
+			if (IsBlankLine(begin, end))
+				continue;
+			text.append(begin, end);
+			offsets.push_back(text.size());
+			lineNumbers.push_back(m_lineNumber);
+		}
+		size_t count = lineNumbers.size();
+		if (count == 0)
+			return true;
+		records.assign(count, Json::Value());
+		//߳̽
+		unsigned workers = static_cast<unsigned>(
+			std::min<size_t>(threadCount, (count + batchSize - 1) / batchSize));
+		size_t slice = (count + workers - 1) / workers;
+		auto parseSlice = [&](unsigned index)
+		{
+			failed[index] = count;
+			size_t first = index * slice;
+			size_t last = std::min(count, first + slice);
+			for (size_t i = first; i < last; ++i)
+			{
+				const char* data = text.data();
+				if (!ParseLine(*readers[index], data + offsets[i],
+					data + offsets[i + 1], records[i], &errors[index]))
+				{
+					failed[index] = i;
+					return;
+				}
+			}
+		};
+		std::vector<std::thread> threads;
+		for (unsigned i = 1; i < workers; ++i)
+			threads.emplace_back(parseSlice, i);
+		parseSlice(0);
+		for (std::thread& t : threads)
+			t.join();
+		//ԭʼ˳ص,һ¼ֹͣ
+		for (size_t i = 0; i < count; ++i)
+		{
+			unsigned index = static_cast<unsigned>(i / slice);
+			if (failed[index] == i)
+			{
+				m_errInfo = "Line " + std::to_string(lineNumbers[i]) + ": " + errors[index];
+				return false;
+			}
+			if (!func(records[i]))
+				return true;
+		}
+	}
+}
+//////////////////////////////////////////////////////////////////////////
+CJsonLinesWriter::CJsonLinesWriter()
+	: m_writer("", false)
+{
+}
+
+CJsonLinesWriter::~CJsonLinesWriter()
+{
+	Close();
+}
+
+bool CJsonLinesWriter::OpenFile(const Json::String& jsonFile, bool append, size_t bufferSize)
+{
+	Close();
+	//ڴļ֮ǰ
+	m_buffer.resize(std::max<size_t>(bufferSize, 4096));
+	m_file.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+	m_file.open(jsonFile, append ? std::ios::binary | std::ios::app : std::ios::binary | std::ios::trunc);
+	return m_file.is_open();
+}
+
+bool CJsonLinesWriter::Write(const Json::Value& record)
+{
+	if (!m_file.is_open())
+		return false;
+	m_line.clear();
+	m_writer.Write(record, m_line);
+	m_line.push_back('\n');
+	m_file.write(m_line.data(), static_cast<std::streamsize>(m_line.size()));
+	return m_file.good();
+}
+
+bool CJsonLinesWriter::Flush()
+{
+	if (!m_file.is_open())
+		return false;
+	m_file.flush();
+	return m_file.good();
+}
+
+void CJsonLinesWriter::Close()
+{
+	if (m_file.is_open())
+		m_file.close();
+	m_file.clear();
+}
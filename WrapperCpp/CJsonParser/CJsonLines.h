@@ -0,0 +1,73 @@
+#ifndef CJSON_LINES_H
+#define CJSON_LINES_H
+
+#include "jsoncpp/json.h"
+#include "CJsonWriter.h"
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <vector>
+//JSON Lines(NDJSON)ȡ,һȡýм¼
+class CJsonLinesReader
+{
+public:
+	CJsonLinesReader();
+	~CJsonLinesReader();
+	//ļ(ȡ,ڴռļС޹)
+	bool OpenFile(const Json::String& jsonFile, size_t bufferSize = 1 << 20);
+	//ڴ(ڶȡڼ뱣Ч)
+	bool OpenBuffer(const char* begin, const char* end);
+	//رԴ
+	void Close();
+	//ȡһ¼(,ݽfalse)
+	bool Next(Json::Value& record);
+	//߳̽ʣ¼ԭʼ˳ص(threadCountΪ0ʱʹȫ,صfalseֹͣ)
+	bool ReadAll(const std::function<bool(Json::Value&)>& func,
+		unsigned threadCount = 0, size_t batchSize = 1024);
+	//ȡ¼к(1ʼ)
+	size_t GetLineNumber() const { return m_lineNumber; }
+	//ôϢ
+	Json::String GetErrorInfo() const { return m_errInfo; }
+private:
+	//ȡһ(з)
+	bool NextLine(const char*& begin, const char*& end);
+	//ļ
+	bool FillBuffer();
+	//һ
+	static bool ParseLine(Json::CharReader& reader, const char* begin,
+		const char* end, Json::Value& record, Json::String* err);
+	std::unique_ptr<Json::CharReader> m_reader;
+	std::ifstream m_file;
+	std::vector<char> m_buffer;
+	size_t m_bufferSize = 0;
+	const char* m_cur = nullptr;
+	const char* m_end = nullptr;
+	bool m_eof = true;
+	size_t m_lineNumber = 0;
+	Json::String m_errInfo;
+};
+
+//JSON Lines(NDJSON)д,¼д뻺ٳɿдļ
+class CJsonLinesWriter
+{
+public:
+	CJsonLinesWriter();
+	~CJsonLinesWriter();
+	//ļ(appendΪtrueʱ׷ӵļĩβ)
+	bool OpenFile(const Json::String& jsonFile, bool append = false,
+		size_t bufferSize = 1 << 20);
+	//дһ¼
+	bool Write(const Json::Value& record);
+	//ѻдļ
+	bool Flush();
+	//رļ
+	void Close();
+private:
+	CJsonWriter m_writer;
+	//ǰ¼л(ڴ)
+	Json::String m_line;
+	std::vector<char> m_buffer;
+	std::ofstream m_file;
+};
+
+#endif	//CJSON_LINES_H
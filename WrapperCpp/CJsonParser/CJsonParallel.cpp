@@ -0,0 +1,209 @@
+#include "CJsonParallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+namespace
+{
+	inline bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+	inline const char* SkipSpaces(const char* p, const char* end)
+	{
+		while (p != end && IsSpace(*p))
+			++p;
+		return p;
+	}
+	inline const char* SkipSpacesBack(const char* begin, const char* p)
+	{
+		while (p != begin && IsSpace(p[-1]))
+			--p;
+		return p;
+	}
+	//ԤɨҪַ
+	struct StructuralTable
+	{
+		bool marks[256] = {};
+		StructuralTable()
+		{
+			for (unsigned char c : { '"', '{', '}', '[', ']', ',', '/' })
+				marks[c] = true;
+		}
+	};
+	const StructuralTable g_structural;
+
+	Json::CharReader* NewReader(bool failIfExtra)
+	{
+		Json::CharReaderBuilder ReaderBuilder;
+		ReaderBuilder["failIfExtra"] = failIfExtra;
+		ReaderBuilder["trackOffsets"] = false;
+		//̵߳ջС,Ƕöϵջ
+		ReaderBuilder["iterativeParse"] = true;
+		return ReaderBuilder.newCharReader();
+	}
+
+	bool ParseWhole(const char* begin, const char* end, Json::Value& root, Json::String* err)
+	{
+		std::unique_ptr<Json::CharReader> reader(NewReader(false));
+		Json::String strerr;
+		bool ok = reader->parse(begin, end, &root, &strerr);
+		if (err)
+			*err = strerr;
+		return ok;
+	}
+}
+
+bool CJsonParallelParser::ScanElements(const char* begin, const char* end,
+	std::vector<std::pair<const char*, const char*>>& elements)
+{
+	elements.clear();
+	const char* p = begin;
+	//UTF-8 BOM
+	if (end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+		p += 3;
+	p = SkipSpaces(p, end);
+	if (p == end || *p != '[')
+		return false;
+	const char* elementBegin = ++p;
+	//δպϵ(Ͳƥʱͨ)
+	std::vector<char> open(1, '[');
+	while (p != end)
+	{
+		if (!g_structural.marks[static_cast<unsigned char>(*p)])
+		{
+			++p;
+			continue;
+		}
+		switch (*p)
+		{
+		case '"':
+		{
+			//ҵǰ治бܵ
+			const char* q = p + 1;
+			while (true)
+			{
+				q = static_cast<const char*>(std::memchr(q, '"', static_cast<size_t>(end - q)));
+				if (!q)
+					return false;
+				const char* s = q;
+				while (s != p + 1 && s[-1] == '\\')
+					--s;
+				if (((q - s) & 1) == 0)
+					break;
+				++q;
+			}
+			p = q;
+			break;
+		}
+		case '{':
+		case '[':
+			open.push_back(*p);
+			break;
+		case '}':
+		case ']':
+			if (open.back() != (*p == '}' ? '{' : '['))
+				return false;
+			open.pop_back();
+			if (open.empty())
+			{
+				//,ֻ֮հ
+				if (SkipSpaces(p + 1, end) != end)
+					return false;
+				const char* b = SkipSpaces(elementBegin, p);
+				if (b != p)
+					elements.emplace_back(b, SkipSpacesBack(b, p));
+				else if (!elements.empty())
+					return false;
+				return true;
+			}
+			break;
+		case ',':
+			if (open.size() == 1)
+			{
+				const char* b = SkipSpaces(elementBegin, p);
+				//Ԫؽͨ
+				if (b == p)
+					return false;
+				elements.emplace_back(b, SkipSpacesBack(b, p));
+				elementBegin = p + 1;
+			}
+			break;
+		default:
+			//עͽͨ
+			return false;
+		}
+		++p;
+	}
+	return false;
+}
+
+bool CJsonParallelParser::Parse(const char* begin, const char* end, Json::Value& root,
+	Json::String* err, unsigned threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::pair<const char*, const char*>> elements;
+	if (threadCount <= 1 || static_cast<size_t>(end - begin) < kMinParallelSize
+		|| !ScanElements(begin, end, elements) || elements.size() < 2)
+		return ParseWhole(begin, end, root, err);
+	//ֽԪؾȷָ߳
+	threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, elements.size()));
+	std::vector<size_t> bounds(threadCount + 1, elements.size());
+	bounds[0] = 0;
+	const size_t total = static_cast<size_t>(elements.back().second - elements.front().first);
+	for (size_t i = 0, part = 1; i < elements.size() && part < threadCount; ++i)
+	{
+		size_t done = static_cast<size_t>(elements[i].first - elements.front().first);
+		if (done >= total / threadCount * part)
+			bounds[part++] = i;
+	}
+	std::vector<std::vector<Json::Value>> results(threadCount);
+	std::vector<Json::String> errors(threadCount);
+	std::vector<size_t> failed(threadCount, elements.size());
+	auto parseRange = [&](unsigned t)
+	{
+		//Ԫرǡһֵ
+		std::unique_ptr<Json::CharReader> reader(NewReader(true));
+		std::vector<Json::Value>& out = results[t];
+		out.resize(bounds[t + 1] - bounds[t]);
+		for (size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+		{
+			if (!reader->parse(elements[i].first, elements[i].second,
+				&out[i - bounds[t]], &errors[t]))
+			{
+				failed[t] = i;
+				return;
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (unsigned t = 1; t < threadCount; ++t)
+		threads.emplace_back(parseRange, t);
+	parseRange(0);
+	for (std::thread& t : threads)
+		t.join();
+	for (unsigned t = 0; t < threadCount; ++t)
+	{
+		if (failed[t] != elements.size())
+		{
+			if (err)
+				*err = "Element " + std::to_string(failed[t]) + " at offset "
+					+ std::to_string(elements[failed[t]].first - begin) + ":\n" + errors[t];
+			return false;
+		}
+	}
+	//ԭ˳ϲ
+	Json::Value array(Json::arrayValue);
+	for (std::vector<Json::Value>& part : results)
+	{
+		for (Json::Value& v : part)
+			array.append(std::move(v));
+		std::vector<Json::Value>().swap(part);
+	}
+	root.swap(array);
+	if (err)
+		err->clear();
+	return true;
+}
@@ -0,0 +1,20 @@
+#ifndef CJSON_PARALLEL_H
+#define CJSON_PARALLEL_H
+
+#include "jsoncpp/json.h"
+#include <vector>
+//߳̽,ԤɨԪرֶ߽βн,ٰԭ˳ϲ
+class CJsonParallelParser
+{
+public:
+	//ĵ(ڵ㲻,עͻݽСʱͨʽ߳̽;threadCountΪ0ʱʹȫ)
+	static bool Parse(const char* begin, const char* end, Json::Value& root,
+		Json::String* err = nullptr, unsigned threadCount = 0);
+	//Ԥɨ,õÿԪصķΧ(ַת,Ǽʱfalse)
+	static bool ScanElements(const char* begin, const char* end,
+		std::vector<std::pair<const char*, const char*>>& elements);
+	//СڸôСĵн
+	static const size_t kMinParallelSize = 1 << 20;
+};
+
+#endif	//CJSON_PARALLEL_H
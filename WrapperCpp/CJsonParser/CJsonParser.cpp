@@ -1,5 +1,10 @@
 #include "CJsonParser.h"
+#include "CJsonFileMap.h"
+#include "CJsonParallel.h"
+#include "CJsonWriter.h"
 
+#include <charconv>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 Json::Value CJsonParser::String2Json(const Json::String& jsonString, Json::String* err)
@@ -8,6 +13,10 @@ Json::Value CJsonParser::String2Json(const Json::String& jsonString, Json::Strin
 	Json::CharReaderBuilder ReaderBuilder;
 	//utf8֧
 	ReaderBuilder["emitUTF8"] = true;
+	//¼ڵıеλ
+	ReaderBuilder["trackOffsets"] = false;
+	//öϵջǶ,ռ߳ջ
+	ReaderBuilder["iterativeParse"] = true;
 	//jsonȡ
 	std::unique_ptr<Json::CharReader> charread(ReaderBuilder.newCharReader());
 	//json
@@ -27,55 +36,232 @@ Json::Value CJsonParser::String2Json(const Json::String& jsonString, Json::Strin
 Json::String CJsonParser::Json2String(
 	const Json::Value& json, bool indented)
 {
-	//Jsonд
-	Json::StreamWriterBuilder writebuild;
-	//utf8֧
-	writebuild["emitUTF8"] = true;
-	//ʽ
-	if(indented)
-		writebuild.settings_["indentation"] = "";
-	//jsonתΪַ
-	Json::String document = Json::writeString(writebuild, json);
-	return document;
+	//ֱлַ(utf8ԭ,̿ɻԭʽ)
+	CJsonWriter writer(indented ? "" : "\t");
+	return writer.ToString(json);
 }
 bool CJsonParser::SaveJson(const Json::Value& json,
-	const Json::String& saveFile, bool indented)
+	const Json::String& saveFile, bool indented, bool sync)
+{
+	//ֿдʱļ,ĵַ,;ʧܲƻԭļ
+	CJsonWriter writer(indented ? "" : "\t");
+	return writer.WriteFile(json, saveFile, sync);
+}
+bool CJsonParser::SaveBinary(const Json::Value& json, const Json::String& saveFile,
+	CJsonBinary::Format format, bool sync)
+{
+	return CJsonBinary::SaveFile(json, saveFile, format, sync);
+}
+bool CJsonParser::ParseEvents(const Json::String& jsonString,
+	Json::ValueHandler& handler, Json::String* err)
+{
+	Json::CharReaderBuilder ReaderBuilder;
+	return Json::parseEvents(ReaderBuilder, jsonString.c_str(),
+		jsonString.c_str() + jsonString.size(), handler, err);
+}
+
+bool CJsonParser::ParseFileEvents(const Json::String& jsonFile,
+	Json::ValueHandler& handler, Json::String* err)
 {
-	//jsonתΪַ
-	Json::String document = Json2String(json, indented);
-	//
-	std::ofstream ofile(saveFile);
-	if (!ofile.is_open())
+	//ӳļ,ʱֻռù̶ڴ
+	CJsonFileMap file;
+	if (!file.Open(jsonFile))
+	{
+		if (err)
+			*err = "Failed to open file: " + jsonFile;
 		return false;
-	ofile << document;
-	ofile.close();
-	return true;
+	}
+	Json::CharReaderBuilder ReaderBuilder;
+	return Json::parseEvents(ReaderBuilder, file.Begin(), file.End(), handler, err);
 }
+
+CJsonParser::CJsonParser(const CJsonParser& other)
+{
+	*this = other;
+}
+
+CJsonParser& CJsonParser::operator=(const CJsonParser& other)
+{
+	if (this == &other)
+		return *this;
+	m_root = other.m_root;
+	//ݶڶ,Ҫԭڴ
+	m_arena.reset();
+	m_keys.reset();
+	m_useArena = other.m_useArena;
+	m_useKeyTable = other.m_useKeyTable;
+	m_parallelThreads = other.m_parallelThreads;
+	//ĵдԭĵ־
+	m_journal.reset();
+	m_errInfo = other.m_errInfo;
+	m_nodes.clear();
+	//ռ·µĸؽα
+	for (const node& n : other.m_nodes)
+	{
+		if (m_nodes.empty())
+			m_nodes.push_back(node{ n.key, &m_root });
+		else
+			m_nodes.push_back(node{ n.key, &(*m_nodes.rbegin()->obj)[n.key] });
+	}
+	return *this;
+}
+
 bool CJsonParser::OpenFile(const Json::String& jsonFile)
 {
-	//ļ
-	std::ifstream ifile;
-	ifile.open(jsonFile);
-	//jsonȡ
-	Json::CharReaderBuilder ReaderBuilder;
-	//utf8֧
-	ReaderBuilder["emitUTF8"] = true;
-	//ļתΪjson
+	//ļ(ڴӳ,ӳֱӽȡ)
+	CJsonFileMap file;
+	if (!file.Open(jsonFile))
+	{
+		m_errInfo = "Failed to open file: " + jsonFile;
+		return false;
+	}
+	return LoadDocument(file.Begin(), file.End(), jsonFile, true);
+}
+
+bool CJsonParser::OpenString(const Json::String& jsonString)
+{
+	return LoadDocument(jsonString.c_str(),
+		jsonString.c_str() + jsonString.size(), "", false);
+}
+
+bool CJsonParser::OpenBinaryFile(const Json::String& binaryFile, CJsonBinary::Format format)
+{
 	Json::Value root;
-	bool ok = Json::parseFromStream(ReaderBuilder,
-		ifile, &root, &m_errInfo);
-	if (!ok) 
+	if (!CJsonBinary::LoadFile(binaryFile, format, root, &m_errInfo))
 		return false;
-	m_nodes.push_back(node{ jsonFile, root });
+	m_errInfo.clear();
+	m_journal.reset();
+	m_nodes.clear();
+	m_root.swap(root);
+	//ݱڴͷ֮ǰ
+	root = Json::Value();
+	m_arena.reset();
+	m_keys.reset();
+	//¼ļ,SaveFileıдļ
+	m_nodes.push_back(node{ "", &m_root });
 	return true;
 }
 
-bool CJsonParser::OpenString(const Json::String& jsonString)
+bool CJsonParser::OpenJournal(const Json::String& jsonFile, size_t compactSize, bool sync)
+{
+	//ȹرյǰ־,ͬһļͬʱ־
+	m_journal.reset();
+	std::unique_ptr<CJsonJournal> journal(new CJsonJournal());
+	Json::Value root;
+	if (!journal->Open(jsonFile, root, compactSize, sync))
+	{
+		m_errInfo = journal->GetErrorInfo();
+		return false;
+	}
+	m_errInfo.clear();
+	m_nodes.clear();
+	m_root.swap(root);
+	//ݱڴͷ֮ǰ
+	root = Json::Value();
+	m_arena.reset();
+	m_keys.reset();
+	m_nodes.push_back(node{ jsonFile, &m_root });
+	m_journal = std::move(journal);
+	return true;
+}
+
+bool CJsonParser::CompactJournal(bool wait)
+{
+	if (!m_journal)
+		return false;
+	if (!m_journal->Compact(m_root, wait))
+	{
+		m_errInfo = m_journal->GetErrorInfo();
+		return false;
+	}
+	return true;
+}
+
+void CJsonParser::CloseJournal()
+{
+	m_journal.reset();
+}
+
+std::vector<Json::String> CJsonParser::CurrentKeys() const
+{
+	std::vector<Json::String> keys;
+	for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it)
+	{
+		if (it != m_nodes.begin())
+			keys.push_back(it->key);
+	}
+	return keys;
+}
+
+bool CJsonParser::Journal(const std::vector<Json::String>& keys)
+{
+	if (!m_journal)
+		return true;
+	bool ok = m_journal->LogLocation(m_root, keys);
+	if (!ok)
+		m_errInfo = m_journal->GetErrorInfo();
+	m_journal->CompactIfNeeded(m_root);
+	return ok;
+}
+
+void CJsonParser::SetArenaMode(bool enable)
+{
+	m_useArena = enable;
+}
+
+void CJsonParser::SetKeyInterning(bool enable)
+{
+	m_useKeyTable = enable;
+}
+
+void CJsonParser::SetParallelMode(unsigned threadCount)
 {
-	Json::Value root = String2Json(jsonString, &m_errInfo);
-	if (root.isNull() || m_errInfo.size() != 0)
+	m_parallelThreads = threadCount;
+}
+
+bool CJsonParser::LoadDocument(const char* begin, const char* end,
+	const Json::String& key, bool allowNull)
+{
+	//ڴroot֮(ʧǰʱrootп)
+	std::unique_ptr<Json::Arena> arena;
+	std::unique_ptr<Json::KeyTable> keys;
+	//תΪjson
+	Json::Value root;
+	bool ok = false;
+	if (m_parallelThreads > 1 && !m_useArena && !m_useKeyTable)
+	{
+		//ģʽ´鰴Ԫطֶν(̲߳ʹڴغͼ)
+		ok = CJsonParallelParser::Parse(begin, end, root, &m_errInfo, m_parallelThreads);
+	}
+	else
+	{
+		//jsonȡ
+		Json::CharReaderBuilder ReaderBuilder;
+		//utf8֧
+		ReaderBuilder["emitUTF8"] = true;
+		ReaderBuilder["trackOffsets"] = false;
+		ReaderBuilder["iterativeParse"] = true;
+		std::unique_ptr<Json::CharReader> charread(ReaderBuilder.newCharReader());
+		//ڴģʽĵȫڴط
+		if (m_useArena)
+			arena.reset(new Json::Arena());
+		Json::ArenaScope scope(arena.get());
+		//ģʽ¼ֻ¼бһ
+		if (m_useKeyTable)
+			keys.reset(new Json::KeyTable());
+		Json::KeyTableScope keyScope(keys.get());
+		ok = charread->parse(begin, end, &root, &m_errInfo);
+	}
+	if (!ok || (!allowNull && root.isNull()))
 		return false;
-	m_nodes.push_back(node{ "", root });
+	m_journal.reset();
+	m_nodes.clear();
+	m_root.swap(root);
+	//ݱڴͷ֮ǰ
+	root = Json::Value();
+	m_arena = std::move(arena);
+	m_keys = std::move(keys);
+	m_nodes.push_back(node{ key, &m_root });
 	return true;
 }
 
@@ -83,105 +269,315 @@ bool CJsonParser::Into(const Json::String& key)
 {
 	if (m_nodes.size() == 0)
 		return false;
-	Json::Value& obj = m_nodes.rbegin()->obj;
-	if (obj.isNull() || obj.isMember(key))
+	Json::Value& obj = *m_nodes.rbegin()->obj;
+	if (!obj.isObject() || !obj.isMember(key))
 		return false;
-	Json::Value v = obj[key];
+	Json::Value& v = obj[key];
 	if (!v.isObject())
 		return false;
-	m_nodes.push_back(node{ key, v });
+	//ֻ¼ӽڵλ,޸ֱڸ
+	m_nodes.push_back(node{ key, &v });
 	return true;
 }
 
 void CJsonParser::Outof()
 {
-	int count = m_nodes.size();
-	if (count <= 1)
+	if (m_nodes.size() <= 1)
 		return;
-	node back = *m_nodes.rbegin();
 	m_nodes.pop_back();
-	m_nodes.rbegin()->obj[back.key] = back.obj;
 }
 
 Json::String CJsonParser::GetErrorInfo()
 {
 	return m_errInfo;
 }
-void CJsonParser::UpdateData()
+//////////////////////////////////////////////////////////////////////////
+const Json::Value* CJsonParser::FindMember(std::string_view key) const
 {
-	for (auto itor = m_nodes.rbegin(); itor != m_nodes.rend(); ++itor)
-	{
-		auto subItor1 = itor;
-		--subItor1;
-		auto subItor2 = subItor1;
-		--subItor2;
-		node& newData = *subItor1;
-		subItor2->obj[newData.key] = newData.obj;
-	}
+	if (m_nodes.size() == 0)
+		return nullptr;
+	const Json::Value& obj = *m_nodes.rbegin()->obj;
+	if (!obj.isObject())
+		return nullptr;
+	return obj.find(key.data(), key.data() + key.size());
 }
-//////////////////////////////////////////////////////////////////////////
+
 Json::Value CJsonParser::GetValue(const Json::String& key, Json::Value defaultValue)
 {
-	if (m_nodes.size() == 0)
+	//ֻƳԱ,ǰڵ
+	const Json::Value* v = FindMember(key);
+	if (!v)
 		return defaultValue;
-	Json::Value obj = m_nodes.rbegin()->obj;
-	if (obj.isNull() || !obj.isMember(key))
-		return defaultValue;
-	return obj[key];
+	return *v;
 }
 
 bool CJsonParser::GetBool(const Json::String& key, bool defaultValue)
 {
-	Json::Value v = GetValue(key);
-	if (v.isNull())
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
 		return defaultValue;
-	return v.asBool();
+	return v->asBool();
 }
 
 int CJsonParser::GetInt(const Json::String& key, int defaultValue)
 {
-	Json::Value v = GetValue(key);
-	if (v.isNull())
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
 		return defaultValue;
-	return v.asInt();
+	return v->asInt();
 }
 
 double CJsonParser::GetDouble(const Json::String& key, double defaultValue)
 {
-	Json::Value v = GetValue(key);
-	if (v.isNull())
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
 		return defaultValue;
-	return v.asDouble();
+	return v->asDouble();
 }
 
 Json::String CJsonParser::GetString(const Json::String& key, Json::String defaultValue)
 {
-	Json::Value v = GetValue(key);
-	if (v.isNull())
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
 		return defaultValue;
-	return v.asCString();
+	return v->asCString();
 }
 Json::Value CJsonParser::GetArray(const Json::String& key, Json::Value defaultValue)
 {
-	Json::Value v = GetValue(key);
-	if (v.isNull() || !v.isArray())
+	const Json::Value* v = FindMember(key);
+	if (!v || !v->isArray())
+		return defaultValue;
+	return *v;
+}
+//////////////////////////////////////////////////////////////////////////
+bool CJsonParser::PeekBool(std::string_view key, bool defaultValue) const
+{
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
 		return defaultValue;
-	return v;
+	return v->asBool();
+}
+
+int CJsonParser::PeekInt(std::string_view key, int defaultValue) const
+{
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asInt();
+}
+
+double CJsonParser::PeekDouble(std::string_view key, double defaultValue) const
+{
+	const Json::Value* v = FindMember(key);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asDouble();
+}
+
+std::string_view CJsonParser::PeekString(std::string_view key, std::string_view defaultValue) const
+{
+	const Json::Value* v = FindMember(key);
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	if (!v || !v->isString() || !v->getString(&begin, &end))
+		return defaultValue;
+	return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+
+const Json::Value& CJsonParser::PeekArray(std::string_view key) const
+{
+	const Json::Value* v = FindMember(key);
+	if (!v || !v->isArray())
+		return Json::Value::nullSingleton();
+	return *v;
+}
+
+const Json::Value& CJsonParser::PeekValue(std::string_view key) const
+{
+	const Json::Value* v = FindMember(key);
+	if (!v)
+		return Json::Value::nullSingleton();
+	return *v;
 }
 //////////////////////////////////////////////////////////////////////////
+const Json::Value* CJsonParser::Find(const CJsonPath& path) const
+{
+	if (m_nodes.size() == 0)
+		return nullptr;
+	return path.Resolve(static_cast<const Json::Value&>(*m_nodes.rbegin()->obj));
+}
+
+bool CJsonParser::GetBool(const CJsonPath& path, bool defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asBool();
+}
+
+int CJsonParser::GetInt(const CJsonPath& path, int defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asInt();
+}
+
+double CJsonParser::GetDouble(const CJsonPath& path, double defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asDouble();
+}
+
+Json::String CJsonParser::GetString(const CJsonPath& path, const Json::String& defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asString();
+}
+
+Json::Value CJsonParser::GetValue(const CJsonPath& path, const Json::Value& defaultValue) const
+{
+	//밴ȡһ,Աʱԭ(null)
+	const Json::Value* v = Find(path);
+	if (!v)
+		return defaultValue;
+	return *v;
+}
+
+void CJsonParser::FindAll(const CJsonPathSet& paths, std::vector<const Json::Value*>& results) const
+{
+	if (m_nodes.size() == 0)
+	{
+		results.assign(paths.Size(), nullptr);
+		return;
+	}
+	paths.Resolve(*m_nodes.rbegin()->obj, results);
+}
+
+bool CJsonParser::GetColumns(const CJsonPath& arrayPath, CJsonColumns& columns) const
+{
+	if (m_nodes.size() == 0)
+		return columns.ReadValue(Json::Value::nullSingleton(), arrayPath);
+	return columns.ReadValue(*m_nodes.rbegin()->obj, arrayPath);
+}
+//////////////////////////////////////////////////////////////////////////
+bool CJsonParser::SetValue(const CJsonPath& path, const Json::Value& value)
+{
+	if (value.isNull())
+		return false;
+	return SetValue(path, Json::Value(value));
+}
+
+bool CJsonParser::SetValue(const CJsonPath& path, Json::Value&& value)
+{
+	if (value.isNull() || !path.IsValid())
+		return false;
+	if (m_nodes.size() == 0)
+	{
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	Json::Value* v = path.Make(*m_nodes.rbegin()->obj);
+	if (!v)
+		return false;
+	//ƶֵǽ,ֵ(ñڴػ)ύ,ʱٸֵ
+	*v = Json::Value(std::move(value));
+	if (!m_journal)
+		return true;
+	std::vector<Json::String> keys = CurrentKeys();
+	for (size_t i = 0; i < path.Size(); ++i)
+		keys.push_back(path.GetKey(i));
+	return Journal(keys);
+}
+
+bool CJsonParser::ApplyPatch(const Json::Value& patch)
+{
+	if (m_nodes.size() == 0)
+	{
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	//ֻ޸ĵǰڵ֮ڵ,αϵĽڵ㱣Ч
+	if (!CJsonPatch::Apply(*m_nodes.rbegin()->obj, patch, &m_errInfo))
+		return false;
+	if (!m_journal)
+		return true;
+	//˳¼ÿ漰λõֵ
+	bool ok = true;
+	const std::vector<Json::String> base = CurrentKeys();
+	for (const Json::Value& op : patch)
+	{
+		for (const char* member : { "from", "path" })
+		{
+			const Json::Value* pointer = op.find(member, member + std::strlen(member));
+			if (!pointer || (std::strcmp(member, "from") == 0 && op["op"].asString() != "move"))
+				continue;
+			CJsonPath path(pointer->asString());
+			std::vector<Json::String> keys = base;
+			for (size_t i = 0; i < path.Size(); ++i)
+				keys.push_back(path.GetKey(i));
+			ok = Journal(keys) && ok;
+		}
+	}
+	return ok;
+}
+
+void CJsonParser::ApplyMergePatch(const Json::Value& patch)
+{
+	if (m_nodes.size() == 0)
+	{
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	CJsonPatch::ApplyMerge(*m_nodes.rbegin()->obj, patch);
+	if (m_journal)
+	{
+		if (!m_journal->LogMerge(CurrentKeys(), patch))
+			m_errInfo = m_journal->GetErrorInfo();
+		m_journal->CompactIfNeeded(m_root);
+	}
+}
+
+Json::Value CJsonParser::CreatePatch(const Json::Value& target) const
+{
+	if (m_nodes.size() == 0)
+		return CJsonPatch::Diff(Json::Value(), target);
+	return CJsonPatch::Diff(*m_nodes.rbegin()->obj, target);
+}
+
+CJsonSnapshot CJsonParser::CreateSnapshot() const
+{
+	//Ƴڶ,ʹڴʱҲ뱾޹
+	return CJsonSnapshot(Json::Value(m_root));
+}
+
 void CJsonParser::SetValue(const Json::String& key, const Json::Value& value)
+{
+	if (value.isNull())
+		return;
+	SetValue(key, Json::Value(value));
+}
+void CJsonParser::SetValue(const Json::String& key, Json::Value&& value)
 {
 	if (value.isNull())
 		return;
 	if (m_nodes.size() == 0)
 	{
-		Json::Value obj;
-		obj[key] = value;
-		m_nodes.push_back(node{ "", obj });
-		return;
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	Json::Value& obj = *m_nodes.rbegin()->obj;
+	obj[key] = Json::Value(std::move(value));
+	if (m_journal)
+	{
+		std::vector<Json::String> keys = CurrentKeys();
+		keys.push_back(key);
+		Journal(keys);
 	}
-	Json::Value& obj = m_nodes.rbegin()->obj;
-	obj[key] = value;
 }
 void CJsonParser::SetArray(const Json::String& key, const Json::Value& value)
 {
@@ -189,6 +585,55 @@ void CJsonParser::SetArray(const Json::String& key, const Json::Value& value)
 		return;
 	SetValue(key, value);
 }
+void CJsonParser::SetArray(const Json::String& key, Json::Value&& value)
+{
+	if (value.isNull() || !value.isArray())
+		return;
+	SetValue(key, std::move(value));
+}
+Json::Value* CJsonParser::AppendValue(const Json::String& key, Json::Value&& value)
+{
+	if (m_nodes.size() == 0)
+	{
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	Json::Value& array = (*m_nodes.rbegin()->obj)[key];
+	if (!array.isNull() && !array.isArray())
+		return nullptr;
+	Json::Value* item = &array.append(std::move(value));
+	if (m_journal)
+	{
+		std::vector<Json::String> keys = CurrentKeys();
+		keys.push_back(key);
+		Journal(keys);
+	}
+	return item;
+}
+void CJsonParser::Reserve(const Json::String& key, Json::ArrayIndex size, Json::ValueType type)
+{
+	if (type != Json::arrayValue && type != Json::objectValue)
+		return;
+	if (m_nodes.size() == 0)
+	{
+		m_root = Json::Value(Json::objectValue);
+		m_nodes.push_back(node{ "", &m_root });
+	}
+	Json::Value& member = (*m_nodes.rbegin()->obj)[key];
+	if (member.isNull())
+	{
+		//½ĿճԱҲҪ¼
+		member = Json::Value(type);
+		if (m_journal)
+		{
+			std::vector<Json::String> keys = CurrentKeys();
+			keys.push_back(key);
+			Journal(keys);
+		}
+	}
+	if (member.isArray() || member.isObject())
+		member.reserve(size);
+}
 void CJsonParser::SetBool(const Json::String& key, const bool& value, bool setStringFormat)
 {
 	if (setStringFormat)
@@ -199,14 +644,32 @@ void CJsonParser::SetBool(const Json::String& key, const bool& value, bool setSt
 void CJsonParser::SetInt(const Json::String& key, const int& value, bool setStringFormat)
 {
 	if (setStringFormat)
-		SetValue(key, std::to_string(value));
+	{
+		//ֱӸʽջϵĻ,ʱַ
+		char buffer[16];
+		std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		SetValue(key, Json::Value(buffer, r.ptr));
+	}
 	else
 		SetValue(key, value);
 }
 void CJsonParser::SetDouble(const Json::String& key, const double& value, bool setStringFormat)
 {
 	if (setStringFormat)
+	{
+#if defined(__cpp_lib_to_chars)
+		//std::to_stringͬ"%f"ʽ,ļֵstd::to_string
+		char buffer[64];
+		std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer),
+			value, std::chars_format::fixed, 6);
+		if (r.ec == std::errc())
+		{
+			SetValue(key, Json::Value(buffer, r.ptr));
+			return;
+		}
+#endif
 		SetValue(key, std::to_string(value));
+	}
 	else
 		SetValue(key, value);
 }
@@ -216,27 +679,28 @@ void CJsonParser::SetString(const Json::String& key, const Json::String& value)
 }
 
 
-bool CJsonParser::SaveFile(Json::String jsonFile, bool indented)
+bool CJsonParser::SaveFile(Json::String jsonFile, bool indented, bool sync)
 {
-	UpdateData();
 	if (m_nodes.size() <= 0)
 		return false;
 	node& content = *m_nodes.begin();
 	if (jsonFile.empty())
 		jsonFile = content.key;
-	if (jsonFile.empty() || content.obj.isNull())
+	if (jsonFile.empty() || m_root.isNull())
 		return false;
-	return SaveJson(content.obj, jsonFile, indented);
+	return SaveJson(m_root, jsonFile, indented, sync);
+}
+bool CJsonParser::SaveBinaryFile(const Json::String& binaryFile, CJsonBinary::Format format, bool sync)
+{
+	if (m_nodes.size() <= 0 || binaryFile.empty() || m_root.isNull())
+		return false;
+	return SaveBinary(m_root, binaryFile, format, sync);
 }
 Json::String CJsonParser::GetJsonString(bool indented)
 {
-	UpdateData();
 	Json::String ret;
-	if (m_nodes.size() <= 0)
-		return ret;
-	node& content = *m_nodes.begin();
-	if (content.obj.isNull())
+	if (m_nodes.size() <= 0 || m_root.isNull())
 		return ret;
-	ret = Json2String(content.obj, indented);
+	ret = Json2String(m_root, indented);
 	return ret;
 }
\ No newline at end of file
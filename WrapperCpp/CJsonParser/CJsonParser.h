@@ -14,7 +14,16 @@
 #define CJSON_PARSER_H
 
 #include "jsoncpp/json.h"
+#include "CJsonBinary.h"
+#include "CJsonColumns.h"
+#include "CJsonJournal.h"
+#include "CJsonPatch.h"
+#include "CJsonPath.h"
+#include "CJsonSnapshot.h"
 #include <list>
+#include <memory>
+#include <string_view>
+#include <vector>
 class CJsonParser
 {
 public:
@@ -22,14 +31,42 @@ public:
 	static Json::Value String2Json(const Json::String& jsonString, Json::String* err = nullptr);
 	//JsonתΪַ(ʽindentedȡֵtrue.ģʽfalse.ģʽ)
 	static Json::String Json2String(const Json::Value& json, bool indented = true);
-	//ļ
+	//ļ(дʱļٸ,syncΪtrueʱˢ̺ŷ)
 	static bool SaveJson(const Json::Value& json, 
-		const Json::String& saveFile, bool indented = true);
+		const Json::String& saveFile, bool indented = true, bool sync = false);
+	//Ϊļ(CBORMessagePack,ͬдʱļٸ)
+	static bool SaveBinary(const Json::Value& json, const Json::String& saveFile,
+		CJsonBinary::Format format = CJsonBinary::CBOR, bool sync = false);
+	//¼ʽJsonַļ(Json,صfalseʱǰ)
+	static bool ParseEvents(const Json::String& jsonString,
+		Json::ValueHandler& handler, Json::String* err = nullptr);
+	static bool ParseFileEvents(const Json::String& jsonFile,
+		Json::ValueHandler& handler, Json::String* err = nullptr);
 public:
+	CJsonParser() = default;
+	//ʱؽα,ʹڵָ¶Լĸ
+	CJsonParser(const CJsonParser& other);
+	CJsonParser& operator=(const CJsonParser& other);
 	//Jsonļ
 	bool OpenFile(const Json::String& jsonFile);
 	//Jsonַ
 	bool OpenString(const Json::String& jsonString);
+	//ضļ(CBORMessagePack)
+	bool OpenBinaryFile(const Json::String& binaryFile,
+		CJsonBinary::Format format = CJsonBinary::CBOR);
+	//־ʽļ:ؿղط޸־,֮ÿ޸ֻ־׷һ¼
+	//־compactSizeʱں̨ѹΪ¿,syncΪtrueʱÿ¼ˢ
+	bool OpenJournal(const Json::String& jsonFile, size_t compactSize = 4 << 20, bool sync = false);
+	//ѹ־(waitΪfalseʱں̨)
+	bool CompactJournal(bool wait = true);
+	//ر־(֮޸Ĳټ¼)
+	void CloseJournal();
+	//Ƿʹڴĵ(֮صͳһڴط,¼ػʱһͷ)
+	void SetArenaMode(bool enable);
+	//Ƿ(֮صĵͬļֻһ,ʺϴͬṹ¼,ʱн)
+	void SetKeyInterning(bool enable);
+	//ôĵĲн߳(01Ϊ,ڴģʽ²)
+	void SetParallelMode(unsigned threadCount);
 	//ڵ
 	bool Into(const Json::String& key);
 	//ؽڵ
@@ -41,6 +78,24 @@ public:
 	Json::String GetString(const Json::String& key, Json::String defaultValue = Json::String());
 	Json::Value GetArray(const Json::String& key, Json::Value defaultValue = Json::Value());
 	Json::Value GetValue(const Json::String& key, Json::Value defaultValue = Json::Value());
+	//ֱӶȡǰڵ(,ڴ;ַͼ޸Ļ¼ǰЧ)
+	bool PeekBool(std::string_view key, bool defaultValue = false) const;
+	int PeekInt(std::string_view key, int defaultValue = 0) const;
+	double PeekDouble(std::string_view key, double defaultValue = 0.0) const;
+	std::string_view PeekString(std::string_view key, std::string_view defaultValue = std::string_view()) const;
+	const Json::Value& PeekArray(std::string_view key) const;
+	const Json::Value& PeekValue(std::string_view key) const;
+	//Ԥ·(Եǰڵ),·ڷĬֵ
+	const Json::Value* Find(const CJsonPath& path) const;
+	bool GetBool(const CJsonPath& path, bool defaultValue = false) const;
+	int GetInt(const CJsonPath& path, int defaultValue = 0) const;
+	double GetDouble(const CJsonPath& path, double defaultValue = 0.0) const;
+	Json::String GetString(const CJsonPath& path, const Json::String& defaultValue = Json::String()) const;
+	Json::Value GetValue(const CJsonPath& path, const Json::Value& defaultValue = Json::Value()) const;
+	//(ǰ׺ֻһ),results[i]Ӧ·еi·
+	void FindAll(const CJsonPathSet& paths, std::vector<const Json::Value*>& results) const;
+	//Ԥ·(Եǰڵ)Ѽ¼ĸֶΰж(Ƽ¼,Ϣcolumns)
+	bool GetColumns(const CJsonPath& arrayPath, CJsonColumns& columns) const;
 	//õǰڵݣsetStringFormatǿתΪַʽjson
 	void SetBool(const Json::String& key, const bool& value, bool setStringFormat = false);
 	void SetInt(const Json::String& key, const int& value, bool setStringFormat = false);
@@ -48,23 +103,61 @@ public:
 	void SetString(const Json::String& key, const Json::String& value);
 	void SetArray(const Json::String& key, const Json::Value& value);
 	void SetValue(const Json::String& key, const Json::Value& value);
-	//(ļΪձΪǰļ)
-	bool SaveFile(Json::String jsonFile = Json::String(), bool indented = true);
+	//ƶǰڵ()
+	void SetArray(const Json::String& key, Json::Value&& value);
+	void SetValue(const Json::String& key, Json::Value&& value);
+	//ǰڵԱĩβһԪ(Աʱ),ظԪ(Աʱnullptr)
+	//صָ´޸ǰЧ;־ʱÿ׷Ӷ¼,׷SetArray
+	Json::Value* AppendValue(const Json::String& key, Json::Value&& value);
+	//ΪǰڵԱԤռ(Աʱtype),ֻJSONCPP_FLAT_OBJECT_VALUESЧ
+	void Reserve(const Json::String& key, Json::ArrayIndex size, Json::ValueType type = Json::arrayValue);
+	//Ԥ·(Եǰڵ),мڵ㲻ʱԶ
+	bool SetValue(const CJsonPath& path, const Json::Value& value);
+	bool SetValue(const CJsonPath& path, Json::Value&& value);
+	//ԵǰڵӦJSON Patch(RFC 6902),ʧʱǰڵ㱣ԭ״
+	bool ApplyPatch(const Json::Value& patch);
+	//ԵǰڵӦJSON Merge Patch(RFC 7386)
+	void ApplyMergePatch(const Json::Value& patch);
+	//ɰѵǰڵΪtargetJSON Patch
+	Json::Value CreatePatch(const Json::Value& target) const;
+	//ĵֻ,֮󱾶޸ĲӰ
+	CJsonSnapshot CreateSnapshot() const;
+	//(ļΪձΪǰļ,syncΪtrueʱˢ̺ŷ)
+	bool SaveFile(Json::String jsonFile = Json::String(), bool indented = true, bool sync = false);
+	//Ϊļ
+	bool SaveBinaryFile(const Json::String& binaryFile,
+		CJsonBinary::Format format = CJsonBinary::CBOR, bool sync = false);
 	//õǰJSONַ
 	Json::String GetJsonString(bool indented = true);
 	//ôϢ
 	Json::String GetErrorInfo();
 private:
-	//нڵ
-	void UpdateData();
-	//ݽڵ¼
+	//ҵǰڵĳԱ(ڷnullptr)
+	const Json::Value* FindMember(std::string_view key) const;
+	//ǰڵļ(ڵ)
+	std::vector<Json::String> CurrentKeys() const;
+	//¼keysָλõ޸(δ־ʱʲôҲ)
+	bool Journal(const std::vector<Json::String>& keys);
+	//ݲ滻ǰĵ
+	bool LoadDocument(const char* begin, const char* end,
+		const Json::String& key, bool allowNull);
+	//ݽڵ¼(α,ָm_rootڲĶ,뷵ؽڵ㲻)
 	struct node
 	{
 		Json::String key;
-		Json::Value obj;
+		Json::Value* obj;
 	};
 	std::list<node>  m_nodes;
-	//Json::Value m_root;
+	//ڴڸ֮
+	bool m_useArena = false;
+	std::unique_ptr<Json::Arena> m_arena;
+	//ͬڸ֮
+	bool m_useKeyTable = false;
+	std::unique_ptr<Json::KeyTable> m_keys;
+	unsigned m_parallelThreads = 0;
+	//޸־(ʱ)
+	std::unique_ptr<CJsonJournal> m_journal;
+	Json::Value m_root;
 	Json::String m_errInfo;
 };
 
@@ -0,0 +1,453 @@
+#include "CJsonPatch.h"
+#include "CJsonPath.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+namespace
+{
+	//¼(෴˳,ʱĵ¼ʱһ,Ա·ڵָ)
+	struct undo
+	{
+		enum kind
+		{
+			Restore,	//ָ·ϵľֵ
+			RemoveAt,	//ɾ¼ĳԱԪ
+			InsertAt	//ŻɾĳԱԪ
+		};
+		kind type;
+		const CJsonPath* path;
+		Json::ArrayIndex index;
+		Json::Value value;
+		//Żصֵȡһȡֵ(moveֵֻƶ)
+		bool useCarry;
+	};
+
+	//ִһ,ʧʱִеĲ
+	class Patcher
+	{
+	public:
+		Patcher(Json::Value& doc, Json::ArrayIndex opCount) : m_doc(doc)
+		{
+			//ÿ·,Ԥռ·ĵַ
+			m_paths.reserve(static_cast<size_t>(opCount) * 2);
+		}
+		bool Run(const Json::Value& patch, Json::String& err)
+		{
+			for (Json::ArrayIndex i = 0; i < patch.size(); ++i)
+			{
+				if (!RunOperation(patch[i], err))
+				{
+					err = "Operation " + std::to_string(i) + ": " + err;
+					Rollback();
+					return false;
+				}
+			}
+			return true;
+		}
+	private:
+		bool RunOperation(const Json::Value& op, Json::String& err)
+		{
+			if (!op.isObject())
+			{
+				err = "operation is not an object";
+				return false;
+			}
+			const Json::Value* name = op.find("op", "op" + 2);
+			if (!name || !name->isString())
+			{
+				err = "missing 'op'";
+				return false;
+			}
+			const Json::String type = name->asString();
+			const CJsonPath* path = CompileMember(op, "path", err);
+			if (!path)
+				return false;
+			if (type == "add" || type == "replace" || type == "test")
+			{
+				const Json::Value* value = op.find("value", "value" + 5);
+				if (!value)
+				{
+					err = "missing 'value'";
+					return false;
+				}
+				if (type == "add")
+					return Add(*path, Json::Value(*value), err);
+				Json::Value* target = path->Resolve(m_doc);
+				if (!target)
+					return Fail(err, "path not found: ", *path);
+				if (type == "test")
+					return CJsonPatch::Equal(*target, *value) || Fail(err, "test failed: ", *path);
+				Record(undo::Restore, *path, 0, std::move(*target));
+				*target = *value;
+				return true;
+			}
+			if (type == "remove")
+				return Remove(*path, false, err);
+			if (type == "move" || type == "copy")
+			{
+				const CJsonPath* from = CompileMember(op, "from", err);
+				if (!from)
+					return false;
+				const Json::Value* source = from->Resolve(m_doc);
+				if (!source)
+					return Fail(err, "path not found: ", *from);
+				if (type == "copy")
+					return Add(*path, Json::Value(*source), err);
+				const Json::String& f = from->GetPath();
+				const Json::String& p = path->GetPath();
+				if (f == p)
+					return true;
+				//ƶԼӽڵ
+				if (p.size() > f.size() && p.compare(0, f.size(), f) == 0 && p[f.size()] == '/')
+					return Fail(err, "cannot move a value into its own child: ", *from);
+				if (!Remove(*from, true, err))
+					return false;
+				return Add(*path, std::move(m_carry), err);
+			}
+			err = "unknown op '" + type + "'";
+			return false;
+		}
+		const CJsonPath* CompileMember(const Json::Value& op, const char* key, Json::String& err)
+		{
+			const Json::Value* member = op.find(key, key + strlen(key));
+			if (!member || !member->isString())
+			{
+				err = Json::String("missing '") + key + "'";
+				return nullptr;
+			}
+			//ֻJSON Pointer,ܵʽ
+			Json::String text = member->asString();
+			if (!text.empty() && text[0] != '/')
+			{
+				err = "not a JSON Pointer: " + text;
+				return nullptr;
+			}
+			m_paths.emplace_back(text);
+			if (!m_paths.back().IsValid())
+			{
+				err = m_paths.back().GetErrorInfo();
+				return nullptr;
+			}
+			return &m_paths.back();
+		}
+		static bool Fail(Json::String& err, const char* message, const CJsonPath& path)
+		{
+			err = message + path.GetPath();
+			return false;
+		}
+		//±("-"ʾĩβ,add)
+		static bool ArrayIndex(const CJsonPath& path, const Json::Value& array,
+			bool allowEnd, Json::ArrayIndex& index)
+		{
+			if (allowEnd && path.LastKey() == "-")
+			{
+				index = array.size();
+				return true;
+			}
+			return path.LastIndex(index) && (allowEnd ? index <= array.size() : index < array.size());
+		}
+		bool Add(const CJsonPath& path, Json::Value&& value, Json::String& err)
+		{
+			if (path.Size() == 0)
+			{
+				Record(undo::Restore, path, 0, std::move(m_doc));
+				m_doc = std::move(value);
+				return true;
+			}
+			Json::Value* parent = path.ResolveParent(m_doc);
+			if (parent && parent->isObject())
+			{
+				const Json::String& key = path.LastKey();
+				const char* begin = key.data();
+				const char* end = begin + key.size();
+				//гԱʱaddͬreplace
+				if (const Json::Value* found = parent->find(begin, end))
+				{
+					Json::Value* existing = const_cast<Json::Value*>(found);
+					Record(undo::Restore, path, 0, std::move(*existing));
+					*existing = std::move(value);
+				}
+				else
+				{
+					*parent->demand(begin, end) = std::move(value);
+					Record(undo::RemoveAt, path, 0, Json::Value());
+				}
+				return true;
+			}
+			Json::ArrayIndex index = 0;
+			if (parent && parent->isArray() && ArrayIndex(path, *parent, true, index))
+			{
+				parent->insert(index, std::move(value));
+				Record(undo::RemoveAt, path, index, Json::Value());
+				return true;
+			}
+			return Fail(err, "path not found: ", path);
+		}
+		//ɾ·ϵֵ(carryΪtrueʱȡֵm_carry)
+		bool Remove(const CJsonPath& path, bool carry, Json::String& err)
+		{
+			if (path.Size() == 0)
+			{
+				err = "cannot remove the root";
+				return false;
+			}
+			Json::Value* parent = path.ResolveParent(m_doc);
+			Json::Value removed;
+			Json::ArrayIndex index = 0;
+			if (parent && parent->isObject())
+			{
+				const Json::String& key = path.LastKey();
+				if (!parent->removeMember(key.data(), key.data() + key.size(), &removed))
+					return Fail(err, "path not found: ", path);
+			}
+			else if (parent && parent->isArray() && ArrayIndex(path, *parent, false, index))
+				parent->removeIndex(index, &removed);
+			else
+				return Fail(err, "path not found: ", path);
+			if (carry)
+			{
+				m_carry = std::move(removed);
+				Record(undo::InsertAt, path, index, Json::Value(), true);
+			}
+			else
+				Record(undo::InsertAt, path, index, std::move(removed));
+			return true;
+		}
+		void Record(undo::kind type, const CJsonPath& path, Json::ArrayIndex index,
+			Json::Value&& value, bool useCarry = false)
+		{
+			m_undo.push_back(undo{ type, &path, index, std::move(value), useCarry });
+		}
+		void Rollback()
+		{
+			for (auto it = m_undo.rbegin(); it != m_undo.rend(); ++it)
+			{
+				const CJsonPath& path = *it->path;
+				if (it->type == undo::Restore)
+				{
+					Json::Value* target = path.Resolve(m_doc);
+					m_carry = std::move(*target);
+					*target = std::move(it->value);
+					continue;
+				}
+				Json::Value* parent = path.ResolveParent(m_doc);
+				const Json::String& key = path.LastKey();
+				if (it->type == undo::RemoveAt)
+				{
+					if (parent->isObject())
+						parent->removeMember(key.data(), key.data() + key.size(), &m_carry);
+					else
+						parent->removeIndex(it->index, &m_carry);
+				}
+				else
+				{
+					Json::Value value = std::move(it->useCarry ? m_carry : it->value);
+					if (parent->isObject())
+						*parent->demand(key.data(), key.data() + key.size()) = std::move(value);
+					else
+						parent->insert(it->index, std::move(value));
+				}
+			}
+			m_undo.clear();
+		}
+		Json::Value& m_doc;
+		std::vector<CJsonPath> m_paths;
+		std::vector<undo> m_undo;
+		Json::Value m_carry;
+	};
+
+	Json::Value MakeOperation(const char* op, const Json::String& path)
+	{
+		Json::Value operation(Json::objectValue);
+		operation["op"] = op;
+		operation["path"] = path;
+		return operation;
+	}
+
+	void DiffValue(const Json::Value& source, const Json::Value& target,
+		const Json::String& path, Json::Value& patch)
+	{
+		if (CJsonPatch::Equal(source, target))
+			return;
+		if (source.isObject() && target.isObject())
+		{
+			for (auto it = source.begin(); it != source.end(); ++it)
+			{
+				const char* end;
+				const char* name = it.memberName(&end);
+				if (!target.find(name, end))
+					patch.append(MakeOperation("remove", path + "/" + CJsonPatch::EscapeKey(Json::String(name, end))));
+			}
+			for (auto it = target.begin(); it != target.end(); ++it)
+			{
+				const char* end;
+				const char* name = it.memberName(&end);
+				Json::String childPath = path + "/" + CJsonPatch::EscapeKey(Json::String(name, end));
+				if (const Json::Value* old = source.find(name, end))
+					DiffValue(*old, *it, childPath, patch);
+				else
+				{
+					Json::Value operation = MakeOperation("add", childPath);
+					operation["value"] = *it;
+					patch.append(std::move(operation));
+				}
+			}
+			return;
+		}
+		if (source.isArray() && target.isArray())
+		{
+			//ȥͬĿͷβ,ɾԪʱֻӦĲ
+			Json::ArrayIndex sourceSize = source.size();
+			Json::ArrayIndex targetSize = target.size();
+			Json::ArrayIndex head = 0;
+			while (head < sourceSize && head < targetSize && CJsonPatch::Equal(source[head], target[head]))
+				++head;
+			Json::ArrayIndex tail = 0;
+			while (tail < sourceSize - head && tail < targetSize - head
+				&& CJsonPatch::Equal(source[sourceSize - 1 - tail], target[targetSize - 1 - tail]))
+				++tail;
+			Json::ArrayIndex sourceCount = sourceSize - head - tail;
+			Json::ArrayIndex targetCount = targetSize - head - tail;
+			Json::ArrayIndex common = std::min(sourceCount, targetCount);
+			for (Json::ArrayIndex i = head; i < head + common; ++i)
+				DiffValue(source[i], target[i], path + "/" + std::to_string(i), patch);
+			//Ԫشͬһλɾ,ȱٵԪβ
+			Json::String position = path + "/" + std::to_string(head + common);
+			for (Json::ArrayIndex i = common; i < sourceCount; ++i)
+				patch.append(MakeOperation("remove", position));
+			for (Json::ArrayIndex i = common; i < targetCount; ++i)
+			{
+				Json::Value operation = MakeOperation("add", path + "/" + std::to_string(head + i));
+				operation["value"] = target[head + i];
+				patch.append(std::move(operation));
+			}
+			return;
+		}
+		Json::Value operation = MakeOperation("replace", path);
+		operation["value"] = target;
+		patch.append(std::move(operation));
+	}
+}
+
+bool CJsonPatch::Apply(Json::Value& doc, const Json::Value& patch, Json::String* err)
+{
+	Json::String message;
+	bool ok = false;
+	if (!patch.isArray())
+		message = "JSON Patch must be an array of operations";
+	else
+		ok = Patcher(doc, patch.size()).Run(patch, message);
+	if (err)
+		*err = message;
+	return ok;
+}
+
+void CJsonPatch::ApplyMerge(Json::Value& doc, const Json::Value& patch)
+{
+	if (!patch.isObject())
+	{
+		doc = patch;
+		return;
+	}
+	if (!doc.isObject())
+		doc = Json::Value(Json::objectValue);
+	for (auto it = patch.begin(); it != patch.end(); ++it)
+	{
+		const char* end;
+		const char* name = it.memberName(&end);
+		if (it->isNull())
+			doc.removeMember(name, end, nullptr);
+		else
+			ApplyMerge(*doc.demand(name, end), *it);
+	}
+}
+
+Json::Value CJsonPatch::Diff(const Json::Value& source, const Json::Value& target)
+{
+	Json::Value patch(Json::arrayValue);
+	DiffValue(source, target, "", patch);
+	return patch;
+}
+
+Json::Value CJsonPatch::DiffMerge(const Json::Value& source, const Json::Value& target)
+{
+	if (!source.isObject() || !target.isObject())
+		return target;
+	Json::Value patch(Json::objectValue);
+	for (auto it = source.begin(); it != source.end(); ++it)
+	{
+		const char* end;
+		const char* name = it.memberName(&end);
+		if (!target.find(name, end))
+			*patch.demand(name, end) = Json::Value();
+	}
+	for (auto it = target.begin(); it != target.end(); ++it)
+	{
+		const char* end;
+		const char* name = it.memberName(&end);
+		const Json::Value* old = source.find(name, end);
+		if (!old)
+			*patch.demand(name, end) = *it;
+		else if (!Equal(*old, *it))
+			*patch.demand(name, end) = DiffMerge(*old, *it);
+	}
+	return patch;
+}
+
+bool CJsonPatch::Equal(const Json::Value& a, const Json::Value& b)
+{
+	if (a.isNumeric() && b.isNumeric())
+	{
+		if (a.type() == Json::realValue || b.type() == Json::realValue)
+			return a.asDouble() == b.asDouble();
+		if (a.isInt64() && b.isInt64())
+			return a.asInt64() == b.asInt64();
+		return a.isUInt64() && b.isUInt64() && a.asUInt64() == b.asUInt64();
+	}
+	if (a.type() != b.type())
+		return false;
+	if (a.isArray())
+	{
+		if (a.size() != b.size())
+			return false;
+		for (Json::ArrayIndex i = 0; i < a.size(); ++i)
+		{
+			if (!Equal(a[i], b[i]))
+				return false;
+		}
+		return true;
+	}
+	if (a.isObject())
+	{
+		if (a.size() != b.size())
+			return false;
+		for (auto it = a.begin(); it != a.end(); ++it)
+		{
+			const char* end;
+			const char* name = it.memberName(&end);
+			const Json::Value* other = b.find(name, end);
+			if (!other || !Equal(*it, *other))
+				return false;
+		}
+		return true;
+	}
+	return a == b;
+}
+
+Json::String CJsonPatch::EscapeKey(const Json::String& key)
+{
+	if (key.find_first_of("~/") == Json::String::npos)
+		return key;
+	Json::String escaped;
+	for (char c : key)
+	{
+		if (c == '~')
+			escaped += "~0";
+		else if (c == '/')
+			escaped += "~1";
+		else
+			escaped += c;
+	}
+	return escaped;
+}
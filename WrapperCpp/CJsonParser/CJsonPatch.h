@@ -0,0 +1,23 @@
+#ifndef CJSON_PATCH_H
+#define CJSON_PATCH_H
+
+#include "jsoncpp/json.h"
+//JSON Patch(RFC 6902)JSON Merge Patch(RFC 7386),ֱ޸ĵ,δ漰Ľڵ㲻Ʋؽ
+class CJsonPatch
+{
+public:
+	//ӦJSON Patch(),һʧʱִеĲȫ,ĵԭ״
+	static bool Apply(Json::Value& doc, const Json::Value& patch, Json::String* err = nullptr);
+	//ӦMerge Patch(Աϲ,nullʾɾԱ,滻)
+	static void ApplyMerge(Json::Value& doc, const Json::Value& patch);
+	//sourceΪtargetJSON Patch(󰴳ԱȽ,ȥͬβȽ)
+	static Json::Value Diff(const Json::Value& source, const Json::Value& target);
+	//sourceΪtargetMerge Patch(޷ʾֵΪnullĳԱ,滻)
+	static Json::Value DiffMerge(const Json::Value& source, const Json::Value& target);
+	//JSONֵȽֵ(11.0)
+	static bool Equal(const Json::Value& a, const Json::Value& b);
+	//ѼתΪJSON Pointerһ("~"->"~0","/"->"~1")
+	static Json::String EscapeKey(const Json::String& key);
+};
+
+#endif	//CJSON_PATCH_H
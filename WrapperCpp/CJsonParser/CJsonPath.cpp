@@ -0,0 +1,314 @@
+#include "CJsonPath.h"
+
+CJsonPath::CJsonPath(const Json::String& path)
+{
+	Compile(path);
+}
+
+bool CJsonPath::Compile(const Json::String& path)
+{
+	m_tokens.clear();
+	m_errInfo.clear();
+	m_path = path;
+	if (path.empty())
+		m_valid = true;
+	else if (path[0] == '/')
+		m_valid = CompilePointer(path);
+	else
+		m_valid = CompileDotted(path);
+	if (!m_valid)
+		m_tokens.clear();
+	return m_valid;
+}
+
+bool CJsonPath::ParseIndex(const Json::String& s, Json::ArrayIndex& index)
+{
+	if (s.empty() || s.size() > 10 || (s.size() > 1 && s[0] == '0'))
+		return false;
+	unsigned long long value = 0;
+	for (char c : s)
+	{
+		if (c < '0' || c > '9')
+			return false;
+		value = value * 10 + static_cast<unsigned>(c - '0');
+	}
+	if (value >= Json::Value::maxUInt)
+		return false;
+	index = static_cast<Json::ArrayIndex>(value);
+	return true;
+}
+
+bool CJsonPath::AddToken(const Json::String& key, bool indexOnly)
+{
+	token t;
+	t.key = key;
+	t.hasIndex = ParseIndex(key, t.index);
+	t.indexOnly = indexOnly;
+	if (indexOnly && !t.hasIndex)
+	{
+		m_errInfo = "Bad array index '" + key + "' in path: " + m_path;
+		return false;
+	}
+	m_tokens.push_back(std::move(t));
+	return true;
+}
+
+bool CJsonPath::CompilePointer(const Json::String& path)
+{
+	//RFC 6901: "~1"ʾ'/',"~0"ʾ'~'
+	Json::String key;
+	for (size_t i = 1; i <= path.size(); ++i)
+	{
+		if (i == path.size() || path[i] == '/')
+		{
+			AddToken(key, false);
+			key.clear();
+			continue;
+		}
+		char c = path[i];
+		if (c == '~')
+		{
+			char next = i + 1 < path.size() ? path[i + 1] : '\0';
+			if (next != '0' && next != '1')
+			{
+				m_errInfo = "Bad escape sequence in path: " + path;
+				return false;
+			}
+			c = next == '0' ? '~' : '/';
+			++i;
+		}
+		key += c;
+	}
+	return true;
+}
+
+bool CJsonPath::CompileDotted(const Json::String& path)
+{
+	//a.b[0].c  a["x.y"]
+	size_t i = 0;
+	const size_t n = path.size();
+	bool expectKey = true;
+	while (i < n)
+	{
+		if (path[i] == '[')
+		{
+			++i;
+			if (i < n && (path[i] == '"' || path[i] == '\''))
+			{
+				//ڵļ,԰'.''[',бת
+				char quote = path[i++];
+				Json::String key;
+				while (i < n && path[i] != quote)
+				{
+					if (path[i] == '\\' && i + 1 < n)
+						++i;
+					key += path[i++];
+				}
+				if (i + 1 >= n || path[i + 1] != ']')
+				{
+					m_errInfo = "Unterminated quoted key in path: " + path;
+					return false;
+				}
+				i += 2;
+				AddToken(key, false);
+			}
+			else
+			{
+				size_t close = path.find(']', i);
+				if (close == Json::String::npos)
+				{
+					m_errInfo = "Missing ']' in path: " + path;
+					return false;
+				}
+				if (!AddToken(path.substr(i, close - i), true))
+					return false;
+				i = close + 1;
+			}
+			expectKey = false;
+		}
+		else if (path[i] == '.')
+		{
+			if (expectKey)
+			{
+				m_errInfo = "Empty key in path: " + path;
+				return false;
+			}
+			++i;
+			expectKey = true;
+			if (i == n)
+			{
+				m_errInfo = "Empty key in path: " + path;
+				return false;
+			}
+		}
+		else
+		{
+			if (!expectKey)
+			{
+				m_errInfo = "Expected '.' or '[' in path: " + path;
+				return false;
+			}
+			size_t end = path.find_first_of(".[", i);
+			if (end == Json::String::npos)
+				end = n;
+			AddToken(path.substr(i, end - i), false);
+			i = end;
+			expectKey = false;
+		}
+	}
+	return true;
+}
+
+const Json::Value* CJsonPath::Step(const Json::Value& v, const token& t)
+{
+	if (v.isObject() && !t.indexOnly)
+		return v.find(t.key.data(), t.key.data() + t.key.size());
+	if (v.isArray() && t.hasIndex && t.index < v.size())
+		return &v[t.index];
+	return nullptr;
+}
+
+const Json::Value* CJsonPath::Resolve(const Json::Value& root) const
+{
+	if (!m_valid)
+		return nullptr;
+	const Json::Value* v = &root;
+	for (const token& t : m_tokens)
+	{
+		v = Step(*v, t);
+		if (!v)
+			return nullptr;
+	}
+	return v;
+}
+
+Json::Value* CJsonPath::Resolve(Json::Value& root) const
+{
+	return const_cast<Json::Value*>(Resolve(static_cast<const Json::Value&>(root)));
+}
+
+Json::Value* CJsonPath::Make(Json::Value& root) const
+{
+	if (!m_valid)
+		return nullptr;
+	Json::Value* v = &root;
+	for (const token& t : m_tokens)
+	{
+		//սڵ㰴һʹ
+		if (v->isNull())
+			*v = Json::Value(t.indexOnly || (t.key == "-") ? Json::arrayValue : Json::objectValue);
+		if (v->isObject() && !t.indexOnly)
+			v = v->demand(t.key.data(), t.key.data() + t.key.size());
+		else if (v->isArray() && t.key == "-")
+			v = &v->append(Json::Value());
+		else if (v->isArray() && t.hasIndex)
+			v = &(*v)[t.index];
+		else
+			return nullptr;
+	}
+	return v;
+}
+
+const Json::Value* CJsonPath::ResolveParent(const Json::Value& root) const
+{
+	if (!m_valid || m_tokens.empty())
+		return nullptr;
+	const Json::Value* v = &root;
+	for (size_t i = 0; i + 1 < m_tokens.size(); ++i)
+	{
+		v = Step(*v, m_tokens[i]);
+		if (!v)
+			return nullptr;
+	}
+	return v;
+}
+
+Json::Value* CJsonPath::ResolveParent(Json::Value& root) const
+{
+	return const_cast<Json::Value*>(ResolveParent(static_cast<const Json::Value&>(root)));
+}
+
+const Json::String& CJsonPath::LastKey() const
+{
+	static const Json::String empty;
+	return m_tokens.empty() ? empty : m_tokens.back().key;
+}
+
+bool CJsonPath::LastIndex(Json::ArrayIndex& index) const
+{
+	if (m_tokens.empty() || !m_tokens.back().hasIndex)
+		return false;
+	index = m_tokens.back().index;
+	return true;
+}
+//////////////////////////////////////////////////////////////////////////
+CJsonPathSet::CJsonPathSet()
+{
+	Clear();
+}
+
+void CJsonPathSet::Clear()
+{
+	m_nodes.clear();
+	//0ŽڵΪ
+	m_nodes.push_back(trieNode());
+	m_count = 0;
+}
+
+size_t CJsonPathSet::Add(const CJsonPath& path)
+{
+	size_t id = m_count++;
+	if (!path.IsValid())
+		return id;
+	size_t cur = 0;
+	for (const CJsonPath::token& t : path.m_tokens)
+	{
+		size_t next = 0;
+		for (size_t child : m_nodes[cur].children)
+		{
+			if (m_nodes[child].token == t)
+			{
+				next = child;
+				break;
+			}
+		}
+		if (next == 0)
+		{
+			next = m_nodes.size();
+			trieNode node;
+			node.token = t;
+			m_nodes.push_back(std::move(node));
+			m_nodes[cur].children.push_back(next);
+		}
+		cur = next;
+	}
+	m_nodes[cur].paths.push_back(id);
+	return id;
+}
+
+size_t CJsonPathSet::Add(const Json::String& path)
+{
+	return Add(CJsonPath(path));
+}
+
+void CJsonPathSet::Resolve(const Json::Value& root,
+	std::vector<const Json::Value*>& results) const
+{
+	results.assign(m_count, nullptr);
+	Walk(0, root, results);
+}
+
+void CJsonPathSet::Walk(size_t nodeIndex, const Json::Value& v,
+	std::vector<const Json::Value*>& results) const
+{
+	const trieNode& node = m_nodes[nodeIndex];
+	for (size_t id : node.paths)
+		results[id] = &v;
+	//ǰ׺ֻһ
+	for (size_t child : node.children)
+	{
+		const Json::Value* next = CJsonPath::Step(v, m_nodes[child].token);
+		if (next)
+			Walk(child, *next, results);
+	}
+}
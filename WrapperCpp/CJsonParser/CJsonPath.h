@@ -0,0 +1,90 @@
+#ifndef CJSON_PATH_H
+#define CJSON_PATH_H
+
+#include "jsoncpp/json.h"
+#include <vector>
+//ԤJson·,֧JSON Pointer("/a/b/0")ʽ("a.b[0]"),һ,ʱڴ
+class CJsonPath
+{
+public:
+	CJsonPath() = default;
+	explicit CJsonPath(const Json::String& path);
+	//·(ַʾڵ)
+	bool Compile(const Json::String& path);
+	//·ǷЧ
+	bool IsValid() const { return m_valid; }
+	//·
+	size_t Size() const { return m_tokens.size(); }
+	//ñʱԭʼ·
+	const Json::String& GetPath() const { return m_path; }
+	//ôϢ
+	const Json::String& GetErrorInfo() const { return m_errInfo; }
+	//·Ӧ(ڷnullptr)
+	const Json::Value* Resolve(const Json::Value& root) const;
+	Json::Value* Resolve(Json::Value& root) const;
+	//·Ӧ,мڵ㲻ʱԶ(ͳͻnullptr;ϵ"-"ʾ׷)
+	Json::Value* Make(Json::Value& root) const;
+	//·һĸڵһļ±
+	const Json::Value* ResolveParent(const Json::Value& root) const;
+	Json::Value* ResolveParent(Json::Value& root) const;
+	const Json::String& LastKey() const;
+	//iļ(ֲΪ±ַʽ)
+	const Json::String& GetKey(size_t i) const { return m_tokens[i].key; }
+	bool LastIndex(Json::ArrayIndex& index) const;
+private:
+	friend class CJsonPathSet;
+	friend class CJsonColumns;
+	//·еһ(ֲԶ󰴼,鰴±)
+	struct token
+	{
+		Json::String key;
+		Json::ArrayIndex index = 0;
+		bool hasIndex = false;
+		bool indexOnly = false;
+		bool operator==(const token& other) const
+		{
+			return key == other.key && hasIndex == other.hasIndex
+				&& indexOnly == other.indexOnly && index == other.index;
+		}
+	};
+	//ڵǰڵϲһ
+	static const Json::Value* Step(const Json::Value& v, const token& t);
+	//ַתΪ±(ǰ0)
+	static bool ParseIndex(const Json::String& s, Json::ArrayIndex& index);
+	bool CompilePointer(const Json::String& path);
+	bool CompileDotted(const Json::String& path);
+	bool AddToken(const Json::String& key, bool indexOnly);
+	std::vector<token> m_tokens;
+	Json::String m_path;
+	Json::String m_errInfo;
+	bool m_valid = true;
+};
+
+//·,ǰ׺·ǰ׺,һαĵȫ·
+class CJsonPathSet
+{
+public:
+	CJsonPathSet();
+	//·,ڽе(Ч·Ľnullptr)
+	size_t Add(const CJsonPath& path);
+	size_t Add(const Json::String& path);
+	//·
+	size_t Size() const { return m_count; }
+	//·
+	void Clear();
+	//ȫ·,results[i]Ϊi·Ľ(㹻ʱڴ)
+	void Resolve(const Json::Value& root, std::vector<const Json::Value*>& results) const;
+private:
+	struct trieNode
+	{
+		CJsonPath::token token;
+		std::vector<size_t> children;
+		std::vector<size_t> paths;
+	};
+	void Walk(size_t nodeIndex, const Json::Value& v,
+		std::vector<const Json::Value*>& results) const;
+	std::vector<trieNode> m_nodes;
+	size_t m_count = 0;
+};
+
+#endif	//CJSON_PATH_H
@@ -0,0 +1,160 @@
+#include "CJsonSnapshot.h"
+#include "CJsonFileMap.h"
+
+CJsonSnapshot::CJsonSnapshot(Json::Value&& root, uint64_t version)
+	: m_root(std::make_shared<const Json::Value>(std::move(root))), m_version(version)
+{
+}
+
+const Json::Value& CJsonSnapshot::GetRoot() const
+{
+	return m_root ? *m_root : Json::Value::nullSingleton();
+}
+
+const Json::Value* CJsonSnapshot::Find(const CJsonPath& path) const
+{
+	if (!m_root)
+		return nullptr;
+	return path.Resolve(*m_root);
+}
+
+bool CJsonSnapshot::GetBool(const CJsonPath& path, bool defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asBool();
+}
+
+int CJsonSnapshot::GetInt(const CJsonPath& path, int defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asInt();
+}
+
+double CJsonSnapshot::GetDouble(const CJsonPath& path, double defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asDouble();
+}
+
+Json::String CJsonSnapshot::GetString(const CJsonPath& path, const Json::String& defaultValue) const
+{
+	const Json::Value* v = Find(path);
+	if (!v || v->isNull())
+		return defaultValue;
+	return v->asString();
+}
+
+void CJsonSnapshot::FindAll(const CJsonPathSet& paths, std::vector<const Json::Value*>& results) const
+{
+	if (!m_root)
+	{
+		results.assign(paths.Size(), nullptr);
+		return;
+	}
+	paths.Resolve(*m_root, results);
+}
+//////////////////////////////////////////////////////////////////////////
+CJsonSnapshotStore::~CJsonSnapshotStore()
+{
+	WaitReload();
+}
+
+CJsonSnapshotStore::contentPtr CJsonSnapshotStore::Load() const
+{
+#if defined(__cpp_lib_atomic_shared_ptr)
+	return m_current.load(std::memory_order_acquire);
+#else
+	return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+#endif
+}
+
+void CJsonSnapshotStore::Store(contentPtr content)
+{
+	//ɿһȡͷʱ,ڶȡ;ͷ
+#if defined(__cpp_lib_atomic_shared_ptr)
+	m_current.store(std::move(content), std::memory_order_release);
+#else
+	std::atomic_store_explicit(&m_current, std::move(content), std::memory_order_release);
+#endif
+}
+
+CJsonSnapshot CJsonSnapshotStore::Get() const
+{
+	contentPtr current = Load();
+	return current ? *current : CJsonSnapshot();
+}
+
+void CJsonSnapshotStore::Publish(Json::Value&& root)
+{
+	PublishContent(std::make_shared<CJsonSnapshot>(std::move(root)));
+}
+
+void CJsonSnapshotStore::Publish(const CJsonSnapshot& snapshot)
+{
+	//Ѿ޸,ֻ
+	PublishContent(snapshot.m_root ? std::make_shared<CJsonSnapshot>(snapshot) : nullptr);
+}
+
+void CJsonSnapshotStore::PublishContent(std::shared_ptr<CJsonSnapshot> published)
+{
+	//ȡ滻ͬһ,ʱǰյŲᵹ(ȡ߲)
+	std::lock_guard<std::mutex> lock(m_publishMutex);
+	if (published)
+		published->m_version = ++m_version;
+	Store(std::move(published));
+}
+
+bool CJsonSnapshotStore::Reload(const Json::String& file)
+{
+	//ŷ,ȡ߿е
+	Json::String err;
+	Json::Value root;
+	CJsonFileMap map;
+	bool ok = map.Open(file);
+	if (!ok)
+		err = "Failed to open file: " + file;
+	else
+	{
+		Json::CharReaderBuilder ReaderBuilder;
+		ReaderBuilder["trackOffsets"] = false;
+		ReaderBuilder["iterativeParse"] = true;
+		std::unique_ptr<Json::CharReader> charread(ReaderBuilder.newCharReader());
+		ok = charread->parse(map.Begin(), map.End(), &root, &err);
+	}
+	map.Close();
+	if (ok)
+		Publish(std::move(root));
+	std::lock_guard<std::mutex> lock(m_errMutex);
+	m_errInfo = err;
+	return ok;
+}
+
+void CJsonSnapshotStore::ReloadAsync(const Json::String& file, const ReloadCallback& callback)
+{
+	WaitReload();
+	m_loader = std::thread([this, file, callback]()
+	{
+		m_loadOk = Reload(file);
+		if (callback)
+			callback(m_loadOk, GetErrorInfo());
+	});
+}
+
+bool CJsonSnapshotStore::WaitReload()
+{
+	if (m_loader.joinable())
+		m_loader.join();
+	return m_loadOk;
+}
+
+Json::String CJsonSnapshotStore::GetErrorInfo() const
+{
+	std::lock_guard<std::mutex> lock(m_errMutex);
+	return m_errInfo;
+}
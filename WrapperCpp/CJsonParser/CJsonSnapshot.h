@@ -0,0 +1,86 @@
+#ifndef CJSON_SNAPSHOT_H
+#define CJSON_SNAPSHOT_H
+
+#include "jsoncpp/json.h"
+#include "CJsonPath.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+//ֻJsonĵ,ü,ƿղ,߳̿ͬʱȡ
+class CJsonSnapshot
+{
+public:
+	CJsonSnapshot() = default;
+	//ӹĵɿ(versionΪ)
+	explicit CJsonSnapshot(Json::Value&& root, uint64_t version = 0);
+	//Ƿ
+	bool IsValid() const { return m_root != nullptr; }
+	//(տշnull)
+	const Json::Value& GetRoot() const;
+	//
+	uint64_t GetVersion() const { return m_version; }
+	//Ԥ·,·ڷĬֵ
+	const Json::Value* Find(const CJsonPath& path) const;
+	bool GetBool(const CJsonPath& path, bool defaultValue = false) const;
+	int GetInt(const CJsonPath& path, int defaultValue = 0) const;
+	double GetDouble(const CJsonPath& path, double defaultValue = 0.0) const;
+	Json::String GetString(const CJsonPath& path, const Json::String& defaultValue = Json::String()) const;
+	//,results[i]Ӧ·еi·
+	void FindAll(const CJsonPathSet& paths, std::vector<const Json::Value*>& results) const;
+private:
+	friend class CJsonSnapshotStore;
+	//Ųڹ,·пʱָֻ
+	std::shared_ptr<const Json::Value> m_root;
+	uint64_t m_version = 0;
+};
+
+//շ,ȡʱȡõǰ(ȴ),ĵں̨ɺԭ滻
+class CJsonSnapshotStore
+{
+public:
+	//ɻص(ɹ,Ϣ)
+	using ReloadCallback = std::function<void(bool, const Json::String&)>;
+	CJsonSnapshotStore() = default;
+	//ȴ̨
+	~CJsonSnapshotStore();
+	CJsonSnapshotStore(const CJsonSnapshotStore&) = delete;
+	CJsonSnapshotStore& operator=(const CJsonSnapshotStore&) = delete;
+	//õǰ(߳̿ɵ)
+	CJsonSnapshot Get() const;
+	//ĵпյ
+	void Publish(Json::Value&& root);
+	void Publish(const CJsonSnapshot& snapshot);
+	//ڵǰ̼߳ļ(ʧʱֵǰ)
+	bool Reload(const Json::String& file);
+	//ں̨̼߳ļ(һκ̨δʱȵȴ)
+	void ReloadAsync(const Json::String& file, const ReloadCallback& callback = ReloadCallback());
+	//ȴ̨,Ƿɹ
+	bool WaitReload();
+	//һμصĴϢ
+	Json::String GetErrorInfo() const;
+private:
+	using contentPtr = std::shared_ptr<const CJsonSnapshot>;
+	//ԭӵضȡ滻ǰ(һ滻)
+	contentPtr Load() const;
+	void Store(contentPtr content);
+	//Ų滻ǰ
+	void PublishContent(std::shared_ptr<CJsonSnapshot> published);
+#if defined(__cpp_lib_atomic_shared_ptr)
+	std::atomic<contentPtr> m_current;
+#else
+	contentPtr m_current;
+#endif
+	//֮以,֤ŷ滻˳һ
+	std::mutex m_publishMutex;
+	uint64_t m_version = 0;
+	std::thread m_loader;
+	bool m_loadOk = true;
+	mutable std::mutex m_errMutex;
+	Json::String m_errInfo;
+};
+
+#endif	//CJSON_SNAPSHOT_H
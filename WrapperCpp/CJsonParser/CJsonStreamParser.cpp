@@ -0,0 +1,285 @@
+#include "CJsonStreamParser.h"
+
+namespace
+{
+	inline bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+	//ת¼¼ǷҪֹͣ(parseEventsǰʱҲtrue)
+	class StopTracker : public Json::ValueHandler
+	{
+	public:
+		explicit StopTracker(Json::ValueHandler& handler)
+			: m_handler(handler)
+		{
+		}
+		bool onNull() override { return Track(m_handler.onNull()); }
+		bool onBool(bool b) override { return Track(m_handler.onBool(b)); }
+		bool onInt(Json::LargestInt i) override { return Track(m_handler.onInt(i)); }
+		bool onUInt(Json::LargestUInt u) override { return Track(m_handler.onUInt(u)); }
+		bool onDouble(double d) override { return Track(m_handler.onDouble(d)); }
+		bool onString(const char* begin, const char* end) override { return Track(m_handler.onString(begin, end)); }
+		bool onStartObject() override { return Track(m_handler.onStartObject()); }
+		bool onKey(const char* begin, const char* end) override { return Track(m_handler.onKey(begin, end)); }
+		bool onEndObject() override { return Track(m_handler.onEndObject()); }
+		bool onStartArray() override { return Track(m_handler.onStartArray()); }
+		bool onEndArray() override { return Track(m_handler.onEndArray()); }
+		bool IsStopped() const { return m_stopped; }
+	private:
+		bool Track(bool keepGoing)
+		{
+			if (!keepGoing)
+				m_stopped = true;
+			return keepGoing;
+		}
+		Json::ValueHandler& m_handler;
+		bool m_stopped = false;
+	};
+}
+
+CJsonStreamParser::CJsonStreamParser()
+{
+	m_builder["collectComments"] = false;
+	m_reader.reset(m_builder.newCharReader());
+}
+
+CJsonStreamParser::~CJsonStreamParser() = default;
+
+void CJsonStreamParser::SetCallback(const ValueCallback& func)
+{
+	m_callback = func;
+}
+
+void CJsonStreamParser::SetHandler(Json::ValueHandler* handler)
+{
+	m_handler = handler;
+}
+
+void CJsonStreamParser::SetSplitRootArray(bool split)
+{
+	m_splitRoot = split;
+}
+
+void CJsonStreamParser::Reset()
+{
+	m_pending.clear();
+	m_depth = 0;
+	m_inValue = m_inString = m_escape = m_inScalar = false;
+	m_rootOpen = m_rootClosed = m_afterValue = m_expectValue = false;
+	m_failed = m_stopped = false;
+	m_valueCount = 0;
+	m_offset = 0;
+	m_errInfo.clear();
+}
+
+bool CJsonStreamParser::Fail(const Json::String& message)
+{
+	m_failed = true;
+	m_errInfo = message;
+	return false;
+}
+
+bool CJsonStreamParser::BeginValue(size_t offset)
+{
+	if (m_rootClosed)
+		return Fail("Extra data after the root array at offset " + std::to_string(offset));
+	if (m_rootOpen && m_afterValue)
+		return Fail("Missing ',' between array elements at offset " + std::to_string(offset));
+	m_inValue = true;
+	m_expectValue = false;
+	return true;
+}
+
+bool CJsonStreamParser::CompleteValue(const char* begin, const char* end)
+{
+	//ֵݿʱǰĲڻ
+	if (!m_pending.empty())
+	{
+		m_pending.append(begin, end);
+		begin = m_pending.data();
+		end = begin + m_pending.size();
+	}
+	m_inValue = false;
+	m_afterValue = m_rootOpen;
+	++m_valueCount;
+	Json::String err;
+	bool keepGoing = true;
+	if (m_handler)
+	{
+		StopTracker tracker(*m_handler);
+		if (!Json::parseEvents(m_builder, begin, end, tracker, &err))
+			return Fail(err);
+		keepGoing = !tracker.IsStopped();
+	}
+	else
+	{
+		Json::Value value;
+		if (!m_reader->parse(begin, end, &value, &err))
+			return Fail(err);
+		if (m_callback)
+			keepGoing = m_callback(value);
+	}
+	m_pending.clear();
+	if (!keepGoing)
+		m_stopped = true;
+	return keepGoing;
+}
+
+bool CJsonStreamParser::Feed(const Json::String& data)
+{
+	return Feed(data.data(), data.size());
+}
+
+bool CJsonStreamParser::Feed(const char* data, size_t size)
+{
+	if (m_failed || m_stopped)
+		return false;
+	const char* p = data;
+	const char* end = data + size;
+	//δɵֵڱдͷ
+	const char* valueBegin = m_inValue ? data : nullptr;
+	while (p != end)
+	{
+		char c = *p;
+		if (m_inString)
+		{
+			for (; p != end; ++p)
+			{
+				if (m_escape)
+					m_escape = false;
+				else if (*p == '\\')
+					m_escape = true;
+				else if (*p == '"')
+					break;
+			}
+			if (p == end)
+				break;
+			m_inString = false;
+			++p;
+			//ֵַŴ
+			if (m_depth == BaseDepth() && !CompleteValue(valueBegin, p))
+				return false;
+			continue;
+		}
+		if (m_inScalar)
+		{
+			//ֵȱڷָ,ָ´
+			if (IsSpace(c) || c == ',' || c == ']' || c == '}' || c == '"' || c == '{' || c == '[')
+			{
+				m_inScalar = false;
+				if (!CompleteValue(valueBegin, p))
+					return false;
+				continue;
+			}
+			++p;
+			continue;
+		}
+		const size_t offset = m_offset + static_cast<size_t>(p - data);
+		switch (c)
+		{
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			break;
+		case '"':
+			if (!m_inValue)
+			{
+				if (!BeginValue(offset))
+					return false;
+				valueBegin = p;
+			}
+			m_inString = true;
+			break;
+		case '[':
+			if (m_splitRoot && !m_rootOpen && !m_rootClosed && !m_inValue && m_valueCount == 0)
+			{
+				//鱾
+				m_rootOpen = true;
+				m_depth = 1;
+				break;
+			}
+			//fall through
+		case '{':
+			if (!m_inValue)
+			{
+				if (!BeginValue(offset))
+					return false;
+				valueBegin = p;
+			}
+			++m_depth;
+			break;
+		case ']':
+			if (m_rootOpen && !m_inValue)
+			{
+				//֮뻹Ԫ
+				if (m_expectValue)
+					return Fail("Unexpected ']' after ',' at offset " + std::to_string(offset));
+				m_rootOpen = false;
+				m_rootClosed = true;
+				m_afterValue = false;
+				m_depth = 0;
+				break;
+			}
+			//fall through
+		case '}':
+			if (!m_inValue)
+				return Fail(Json::String("Unexpected '") + c + "' at offset " + std::to_string(offset));
+			if (--m_depth == BaseDepth())
+			{
+				++p;
+				if (!CompleteValue(valueBegin, p))
+					return false;
+				continue;
+			}
+			break;
+		case ',':
+			if (m_inValue)
+				break;
+			if (!m_rootOpen || !m_afterValue)
+				return Fail("Unexpected ',' at offset " + std::to_string(offset));
+			m_afterValue = false;
+			m_expectValue = true;
+			break;
+		case '/':
+			return Fail("Comments are not supported at offset " + std::to_string(offset));
+		default:
+			if (!m_inValue)
+			{
+				if (!BeginValue(offset))
+					return false;
+				valueBegin = p;
+				//ıûн,ָʱ
+				m_inScalar = true;
+			}
+			break;
+		}
+		++p;
+	}
+	m_offset += size;
+	//δɵֵ
+	if (m_inValue)
+		m_pending.append(valueBegin, end);
+	return true;
+}
+
+bool CJsonStreamParser::Finish()
+{
+	if (m_failed || m_stopped)
+		return false;
+	//ĩβı
+	if (m_inScalar)
+	{
+		m_inScalar = false;
+		Json::String scalar;
+		scalar.swap(m_pending);
+		if (!CompleteValue(scalar.data(), scalar.data() + scalar.size()))
+			return false;
+	}
+	if (m_inValue)
+		return Fail("Incomplete value at the end of data");
+	if (m_rootOpen)
+		return Fail("Missing ']' at the end of data");
+	return true;
+}
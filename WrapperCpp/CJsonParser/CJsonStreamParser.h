@@ -0,0 +1,72 @@
+#ifndef CJSON_STREAM_PARSER_H
+#define CJSON_STREAM_PARSER_H
+
+#include "jsoncpp/json.h"
+#include <functional>
+#include <memory>
+//Json,ݿɰСֿ,ÿֵص(ֻδɵֵ,֧ע)
+class CJsonStreamParser
+{
+public:
+	//ֵص,falseֹͣ
+	using ValueCallback = std::function<bool(Json::Value&)>;
+	CJsonStreamParser();
+	~CJsonStreamParser();
+	CJsonStreamParser(const CJsonStreamParser&) = delete;
+	CJsonStreamParser& operator=(const CJsonStreamParser&) = delete;
+	//ֵص
+	void SetCallback(const ValueCallback& func);
+	//¼(úֵص,ÿɵֵ¼ʽ,Json)
+	void SetHandler(Json::ValueHandler* handler);
+	//ÿԪصص(鲻建),ǰ
+	void SetSplitRootArray(bool split);
+	//һ(صҪֹͣʱfalse)
+	bool Feed(const char* data, size_t size);
+	bool Feed(const Json::String& data);
+	//ݽ(ĩβֵֵ,Ƿδɵ)
+	bool Finish();
+	//״̬¿ʼ(ص)
+	void Reset();
+	//ɵֵ
+	size_t GetValueCount() const { return m_valueCount; }
+	//ǰδݴС
+	size_t GetPendingSize() const { return m_pending.size(); }
+	//Ƿ񱻻صֹͣ
+	bool IsStopped() const { return m_stopped; }
+	//ôϢ
+	Json::String GetErrorInfo() const { return m_errInfo; }
+private:
+	//ʼһֵ
+	bool BeginValue(size_t offset);
+	//һֵ,ص
+	bool CompleteValue(const char* begin, const char* end);
+	//¼
+	bool Fail(const Json::String& message);
+	//ֵڲ(ָʱΪ1)
+	int BaseDepth() const { return m_rootOpen ? 1 : 0; }
+	Json::CharReaderBuilder m_builder;
+	std::unique_ptr<Json::CharReader> m_reader;
+	ValueCallback m_callback;
+	Json::ValueHandler* m_handler = nullptr;
+	bool m_splitRoot = false;
+	//ɨ״̬,ݿ鱣
+	Json::String m_pending;
+	int m_depth = 0;
+	bool m_inValue = false;
+	bool m_inString = false;
+	bool m_escape = false;
+	bool m_inScalar = false;
+	bool m_rootOpen = false;
+	bool m_rootClosed = false;
+	bool m_afterValue = false;
+	//ж֮δԪ
+	bool m_expectValue = false;
+	bool m_failed = false;
+	bool m_stopped = false;
+	size_t m_valueCount = 0;
+	//֮ǰݿֽ(ڴλ)
+	size_t m_offset = 0;
+	Json::String m_errInfo;
+};
+
+#endif	//CJSON_STREAM_PARSER_H
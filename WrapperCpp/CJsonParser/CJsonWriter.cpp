@@ -0,0 +1,416 @@
+#include "CJsonWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+//SSE2x86-64ĿĻָ,JSONCPP_NO_SIMDʱֻʹֽɨ
+#if !defined(JSONCPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CJSON_WRITER_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+namespace
+{
+	//ģʽ»ﵽôСʱд
+	const size_t kBlockSize = 64 * 1024;
+	//иʽ¼ֵдһе(jsoncppһ)
+	const size_t kRightMargin = 74;
+
+	//Ҫתַ:,бַ(UTF-8ֽԭ)
+	struct EscapeTable
+	{
+		bool marks[256] = {};
+		EscapeTable()
+		{
+			for (int c = 0; c < 0x20; ++c)
+				marks[c] = true;
+			marks['"'] = true;
+			marks['\\'] = true;
+		}
+	};
+	const EscapeTable g_escape;
+
+#if defined(CJSON_WRITER_SSE2)
+	inline unsigned LowestBit(unsigned mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+#endif
+
+	//صһҪתַλ,ÿμ16ֽ
+	const char* FindEscape(const char* p, const char* end)
+	{
+#if defined(CJSON_WRITER_SSE2)
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x1F);
+		while (end - p >= 16)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			//޷űȽx<=0x1F
+			__m128i m = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+				_mm_cmpeq_epi8(_mm_min_epu8(x, control), x));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(m));
+			if (mask)
+				return p + LowestBit(mask);
+			p += 16;
+		}
+#endif
+		while (p != end && !g_escape.marks[static_cast<unsigned char>(*p)])
+			++p;
+		return p;
+	}
+}
+
+CJsonWriter::CJsonWriter(const Json::String& indentation, bool keepComments)
+	: m_indentation(indentation), m_colon(indentation.empty() ? ":" : " : "),
+	m_keepComments(keepComments)
+{
+}
+
+void CJsonWriter::Write(const Json::Value& value, Json::String& out)
+{
+	m_out = &out;
+	m_sink = nullptr;
+	WriteRoot(value);
+	m_out = nullptr;
+}
+
+bool CJsonWriter::Write(const Json::Value& value, std::ostream& os)
+{
+	return WriteBlocks(value, [&os](const char* data, size_t size)
+	{
+		os.write(data, static_cast<std::streamsize>(size));
+		return os.good();
+	});
+}
+
+bool CJsonWriter::Write(const Json::Value& value, CJsonFileWriter& file)
+{
+	return WriteBlocks(value, [&file](const char* data, size_t size)
+	{
+		return file.Write(data, size);
+	});
+}
+
+Json::String CJsonWriter::ToString(const Json::Value& value)
+{
+	Json::String document;
+	Write(value, document);
+	return document;
+}
+
+bool CJsonWriter::WriteFile(const Json::Value& value, const Json::String& file, bool sync)
+{
+	//ڴֻһ黺,дʧʱԭļֲ
+	CJsonFileWriter ofile;
+	if (!ofile.Open(file))
+		return false;
+	if (!Write(value, ofile))
+		return false;
+	return ofile.Commit(sync);
+}
+
+bool CJsonWriter::WriteBlocks(const Json::Value& value,
+	const std::function<bool(const char*, size_t)>& sink)
+{
+	Json::String buffer;
+	buffer.reserve(kBlockSize * 2);
+	m_out = &buffer;
+	m_sink = &sink;
+	m_failed = false;
+	WriteRoot(value);
+	if (!m_failed && !buffer.empty() && !sink(buffer.data(), buffer.size()))
+		m_failed = true;
+	m_out = nullptr;
+	m_sink = nullptr;
+	return !m_failed;
+}
+
+void CJsonWriter::WriteRoot(const Json::Value& value)
+{
+	m_indentString.clear();
+	m_indented = true;
+	WriteCommentBefore(value);
+	if (!m_indented)
+		WriteIndent();
+	m_indented = true;
+	WriteValue(value);
+	WriteCommentAfter(value);
+}
+
+void CJsonWriter::WriteValue(const Json::Value& value)
+{
+	Json::String& out = *m_out;
+	switch (value.type())
+	{
+	case Json::nullValue:
+		out.append("null", 4);
+		break;
+	case Json::intValue:
+	case Json::uintValue:
+	{
+		char buffer[24];
+		std::to_chars_result r = value.type() == Json::intValue
+			? std::to_chars(buffer, buffer + sizeof(buffer), value.asLargestInt())
+			: std::to_chars(buffer, buffer + sizeof(buffer), value.asLargestUInt());
+		out.append(buffer, r.ptr);
+		break;
+	}
+	case Json::realValue:
+		AppendDouble(*m_out, value.asDouble());
+		break;
+	case Json::stringValue:
+	{
+		const char* begin;
+		const char* end;
+		if (value.getString(&begin, &end))
+			AppendString(*m_out, begin, end);
+		break;
+	}
+	case Json::booleanValue:
+		if (value.asBool())
+			out.append("true", 4);
+		else
+			out.append("false", 5);
+		break;
+	case Json::arrayValue:
+		WriteArray(value);
+		break;
+	case Json::objectValue:
+	{
+		if (value.empty())
+		{
+			out.append("{}", 2);
+			break;
+		}
+		WriteWithIndent("{", 1);
+		m_indentString += m_indentation;
+		//Ա˳,ƳԱ
+		for (Json::Value::const_iterator it = value.begin(); it != value.end();)
+		{
+			FlushBlock();
+			const Json::Value& child = *it;
+			WriteCommentBefore(child);
+			if (!m_indented)
+				WriteIndent();
+			const char* nameEnd;
+			const char* name = it.memberName(&nameEnd);
+			AppendString(*m_out, name, nameEnd);
+			m_indented = false;
+			m_out->append(m_colon);
+			WriteValue(child);
+			if (++it != value.end())
+				m_out->push_back(',');
+			WriteCommentAfter(child);
+		}
+		m_indentString.resize(m_indentString.size() - m_indentation.size());
+		WriteWithIndent("}", 1);
+		break;
+	}
+	}
+}
+
+void CJsonWriter::WriteArray(const Json::Value& value)
+{
+	Json::ArrayIndex size = value.size();
+	if (size == 0)
+	{
+		m_out->append("[]", 2);
+		return;
+	}
+	//עʱǶ;ոʽµеĽͬ
+	if (!m_keepComments && !m_indentation.empty() && WriteSingleLineArray(value))
+		return;
+	WriteWithIndent("[", 1);
+	m_indentString += m_indentation;
+	for (Json::ArrayIndex index = 0; index < size; ++index)
+	{
+		FlushBlock();
+		const Json::Value& child = value[index];
+		WriteCommentBefore(child);
+		if (!m_indented)
+			WriteIndent();
+		m_indented = true;
+		WriteValue(child);
+		m_indented = false;
+		if (index + 1 != size)
+			m_out->push_back(',');
+		WriteCommentAfter(child);
+	}
+	m_indentString.resize(m_indentString.size() - m_indentation.size());
+	WriteWithIndent("]", 1);
+}
+
+bool CJsonWriter::WriteSingleLineArray(const Json::Value& value)
+{
+	Json::ArrayIndex size = value.size();
+	if (size * 3 >= kRightMargin)
+		return false;
+	for (Json::ArrayIndex index = 0; index < size; ++index)
+	{
+		const Json::Value& child = value[index];
+		if ((child.isArray() || child.isObject()) && !child.empty())
+			return false;
+		if (child.hasComment(Json::commentBefore) || child.hasComment(Json::commentAfterOnSameLine)
+			|| child.hasComment(Json::commentAfter))
+			return false;
+	}
+	//ֱд,пʱص°(ֵᴥֿд)
+	size_t start = m_out->size();
+	m_out->append("[ ", 2);
+	for (Json::ArrayIndex index = 0; index < size; ++index)
+	{
+		if (index > 0)
+			m_out->append(", ", 2);
+		WriteValue(value[index]);
+	}
+	m_out->append(" ]", 2);
+	if (m_out->size() - start >= kRightMargin)
+	{
+		m_out->resize(start);
+		return false;
+	}
+	return true;
+}
+
+void CJsonWriter::AppendString(Json::String& out, const char* begin, const char* end)
+{
+	static const char hex[] = "0123456789abcdef";
+	out.push_back('"');
+	const char* p = begin;
+	while (true)
+	{
+		//ҪתĲθ
+		const char* q = FindEscape(p, end);
+		out.append(p, static_cast<size_t>(q - p));
+		if (q == end)
+			break;
+		unsigned char c = static_cast<unsigned char>(*q);
+		switch (c)
+		{
+		case '"':
+			out.append("\\\"", 2);
+			break;
+		case '\\':
+			out.append("\\\\", 2);
+			break;
+		case '\b':
+			out.append("\\b", 2);
+			break;
+		case '\f':
+			out.append("\\f", 2);
+			break;
+		case '\n':
+			out.append("\\n", 2);
+			break;
+		case '\r':
+			out.append("\\r", 2);
+			break;
+		case '\t':
+			out.append("\\t", 2);
+			break;
+		default:
+		{
+			char escaped[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+			out.append(escaped, 6);
+			break;
+		}
+		}
+		p = q + 1;
+	}
+	out.push_back('"');
+}
+
+void CJsonWriter::AppendDouble(Json::String& out, double value)
+{
+	if (!std::isfinite(value))
+	{
+		if (std::isnan(value))
+			out.append("null", 4);
+		else
+			out.append(value < 0 ? "-1e+9999" : "1e+9999");
+		return;
+	}
+	//̿ɻԭʽ,ûСָʱ".0"
+#if defined(__cpp_lib_to_chars)
+	char buffer[32];
+	std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	out.append(buffer, r.ptr);
+	if (std::find_if(buffer, r.ptr, [](char c) { return c == '.' || c == 'e'; }) == r.ptr)
+		out.append(".0", 2);
+#else
+	out.append(Json::valueToString(value, 17, Json::PrecisionType::shortestRoundTrip));
+#endif
+}
+
+void CJsonWriter::WriteIndent()
+{
+	if (m_indentation.empty())
+		return;
+	m_out->push_back('\n');
+	m_out->append(m_indentString);
+}
+
+void CJsonWriter::WriteWithIndent(const char* text, size_t size)
+{
+	if (!m_indented)
+		WriteIndent();
+	m_out->append(text, size);
+	m_indented = false;
+}
+
+void CJsonWriter::WriteCommentBefore(const Json::Value& value)
+{
+	if (!m_keepComments || !value.hasComment(Json::commentBefore))
+		return;
+	if (!m_indented)
+		WriteIndent();
+	//ע͵ĺаǰ
+	const Json::String comment = value.getComment(Json::commentBefore);
+	for (size_t i = 0; i < comment.size(); ++i)
+	{
+		m_out->push_back(comment[i]);
+		if (comment[i] == '\n' && i + 1 < comment.size() && comment[i + 1] == '/')
+			m_out->append(m_indentString);
+	}
+	m_indented = false;
+}
+
+void CJsonWriter::WriteCommentAfter(const Json::Value& value)
+{
+	if (!m_keepComments)
+		return;
+	if (value.hasComment(Json::commentAfterOnSameLine))
+	{
+		m_out->push_back(' ');
+		m_out->append(value.getComment(Json::commentAfterOnSameLine));
+	}
+	if (value.hasComment(Json::commentAfter))
+	{
+		WriteIndent();
+		m_out->append(value.getComment(Json::commentAfter));
+	}
+}
+
+void CJsonWriter::FlushBlock()
+{
+	if (!m_sink || m_out->size() < kBlockSize)
+		return;
+	//дʧܺд,ֻ
+	if (!m_failed && !(*m_sink)(m_out->data(), m_out->size()))
+		m_failed = true;
+	m_out->clear();
+}
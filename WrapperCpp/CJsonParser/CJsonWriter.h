@@ -0,0 +1,53 @@
+#ifndef CJSON_WRITER_H
+#define CJSON_WRITER_H
+
+#include "jsoncpp/json.h"
+#include "CJsonFileWriter.h"
+#include <functional>
+#include <iosfwd>
+//Jsonд,ֱлֿд
+//StreamWriterBuilder(emitUTF8,precisionTypeΪshortest)Ľֽһ
+class CJsonWriter
+{
+public:
+	//indentationΪʱոʽ;keepCommentsΪfalseʱע(൱commentStyleΪNone)
+	explicit CJsonWriter(const Json::String& indentation = "\t", bool keepComments = true);
+	//л׷ӵַ
+	void Write(const Json::Value& value, Json::String& out);
+	//лֿд
+	bool Write(const Json::Value& value, std::ostream& os);
+	//лΪַ
+	Json::String ToString(const Json::Value& value);
+	//лֿдԭļ(ύ)
+	bool Write(const Json::Value& value, CJsonFileWriter& file);
+	//л浽ļ(дʱļٸ,syncΪtrueʱˢ)
+	bool WriteFile(const Json::Value& value, const Json::String& file, bool sync = false);
+	//׷Ӵŵתַ
+	static void AppendString(Json::String& out, const char* begin, const char* end);
+	//׷Ӹ(Writeĸʽһ)
+	static void AppendDouble(Json::String& out, double value);
+private:
+	//лͨsinkֿд
+	bool WriteBlocks(const Json::Value& value, const std::function<bool(const char*, size_t)>& sink);
+	void WriteRoot(const Json::Value& value);
+	void WriteValue(const Json::Value& value);
+	void WriteArray(const Json::Value& value);
+	//԰ֵֻдһ(пʱfalse)
+	bool WriteSingleLineArray(const Json::Value& value);
+	void WriteIndent();
+	void WriteWithIndent(const char* text, size_t size);
+	void WriteCommentBefore(const Json::Value& value);
+	void WriteCommentAfter(const Json::Value& value);
+	//ʱһд
+	void FlushBlock();
+	Json::String m_indentation;
+	Json::String m_colon;
+	bool m_keepComments;
+	Json::String m_indentString;
+	bool m_indented = false;
+	Json::String* m_out = nullptr;
+	const std::function<bool(const char*, size_t)>* m_sink = nullptr;
+	bool m_failed = false;
+};
+
+#endif	//CJSON_WRITER_H
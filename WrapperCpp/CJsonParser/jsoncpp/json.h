@@ -253,6 +253,22 @@ bool operator!=(const SecureAllocator<T>&, const SecureAllocator<U>&) {
 #define JSON_USE_NULLREF 1
 #endif
 
+// If non-zero, objects and arrays keep their members in one sorted vector
+// (Json::FlatMap) instead of a std::map. Lookups and iteration touch
+// contiguous memory, but adding or removing a member invalidates references
+// to the other members of the same object. The default is std::map.
+#ifndef JSONCPP_FLAT_OBJECT_VALUES
+#define JSONCPP_FLAT_OBJECT_VALUES 0
+#endif
+
+// If non-zero, Value leaves out the comments pointer and the source offsets,
+// which shrinks every node from 40 to 16 bytes on 64-bit targets. Comments
+// are then neither kept by the reader nor written, and the offset accessors
+// always return 0.
+#ifndef JSONCPP_COMPACT_VALUE
+#define JSONCPP_COMPACT_VALUE 0
+#endif
+
 /// If defined, indicates that the source file is amalgamated
 /// to prevent private header inclusion.
 /// Remarks: it is automatically defined in the generated amalgamated header.
@@ -563,6 +579,7 @@ public:
 #endif
 #endif
 
+#include <algorithm>
 #include <array>
 #include <exception>
 #include <map>
@@ -651,7 +668,8 @@ enum CommentPlacement {
  */
 enum PrecisionType {
   significantDigits = 0, ///< we set max number of significant digits in string
-  decimalPlaces          ///< we set max number of digits after "." in string
+  decimalPlaces,         ///< we set max number of digits after "." in string
+  shortestRoundTrip      ///< shortest string that reads back to the same value
 };
 
 /** \brief Lightweight wrapper to tag static string.
@@ -680,6 +698,272 @@ private:
   const char* c_str_;
 };
 
+/** \brief Bump allocator owning the strings and containers of one document.
+ *
+ * While an ArenaScope is active, CharReader::parse() takes the storage of
+ * every string, member name and container of the parsed tree from the arena
+ * instead of the heap. Nothing is freed individually: the blocks are
+ * returned in one go by release() or the destructor, so every Value built in
+ * the arena must be destroyed first. Copies of such Values are ordinary heap
+ * Values; moving one out of the tree keeps it tied to the arena.
+ */
+class JSON_API Arena {
+public:
+  explicit Arena(size_t blockSize = 64 * 1024);
+  ~Arena();
+  Arena(Arena const&) = delete;
+  Arena& operator=(Arena const&) = delete;
+
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+  /// Return all blocks to the heap.
+  void release();
+  /// Bytes currently reserved from the heap.
+  size_t capacity() const { return capacity_; }
+
+private:
+  struct Block {
+    Block* next_;
+    size_t size_;
+  };
+  Block* newBlock(size_t size);
+
+  Block* head_ = nullptr;
+  char* current_ = nullptr;
+  char* end_ = nullptr;
+  size_t blockSize_;
+  size_t capacity_ = 0;
+};
+
+/** \brief Makes an Arena the allocation target of CharReader::parse() on the
+ * current thread while the scope is alive. Scopes nest.
+ */
+class JSON_API ArenaScope {
+public:
+  explicit ArenaScope(Arena* arena);
+  ~ArenaScope();
+  ArenaScope(ArenaScope const&) = delete;
+  ArenaScope& operator=(ArenaScope const&) = delete;
+  static Arena* current();
+
+private:
+  Arena* previous_;
+};
+
+/** \brief Interned member names of one document.
+ *
+ * While a KeyTableScope is active, CharReader::parse() stores every distinct
+ * member name once in the table and lets all objects of the tree refer to
+ * that copy, so an array of records pays for its field names only once.
+ * Members sharing a name then also share the name pointer, which makes
+ * comparing them cheap. Like an Arena, the table must outlive every Value
+ * built with it; copies of such Values own their names again.
+ */
+class JSON_API KeyTable {
+public:
+  KeyTable();
+  ~KeyTable();
+  KeyTable(KeyTable const&) = delete;
+  KeyTable& operator=(KeyTable const&) = delete;
+
+  /// Return the stored copy of [begin, end), adding it on first use.
+  /// The copy is null terminated.
+  const char* intern(const char* begin, const char* end);
+  /// Number of distinct names.
+  size_t size() const { return size_; }
+
+private:
+  struct Slot {
+    const char* name_;
+    unsigned length_;
+    unsigned hash_;
+  };
+  static unsigned hash(const char* begin, const char* end);
+  const Slot* lookup(const char* begin, unsigned length, unsigned hash) const;
+  void grow();
+
+  Arena names_;
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+};
+
+/** \brief Makes a KeyTable the name store of CharReader::parse() on the
+ * current thread while the scope is alive. Scopes nest.
+ */
+class JSON_API KeyTableScope {
+public:
+  explicit KeyTableScope(KeyTable* keys);
+  ~KeyTableScope();
+  KeyTableScope(KeyTableScope const&) = delete;
+  KeyTableScope& operator=(KeyTableScope const&) = delete;
+  static KeyTable* current();
+
+private:
+  KeyTable* previous_;
+};
+
+/** \brief Allocator of the object/array containers.
+ *
+ * Without an arena it is the plain heap allocator. Copies of a container
+ * always go back to the heap (select_on_container_copy_construction).
+ */
+template <typename T> class ArenaAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const& other) noexcept
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_)
+      return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t) noexcept {
+    if (!arena_)
+      ::operator delete(p);
+  }
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(ArenaAllocator<U> const& other) const {
+    return arena_ == other.arena();
+  }
+  template <typename U>
+  bool operator!=(ArenaAllocator<U> const& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  Arena* arena_ = nullptr;
+};
+
+/** \brief Sorted-vector map with the subset of the std::map interface used
+ * for object members (see JSONCPP_FLAT_OBJECT_VALUES).
+ *
+ * Appending keys in order, as the reader does for arrays, needs no search
+ * and no move of existing members.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+class FlatMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using allocator_type = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<value_type>;
+
+private:
+  using Storage = std::vector<value_type, allocator_type>;
+
+public:
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+  using size_type = typename Storage::size_type;
+
+  FlatMap() = default;
+  explicit FlatMap(allocator_type const& alloc) : data_(alloc) {}
+
+  iterator begin() noexcept { return data_.begin(); }
+  iterator end() noexcept { return data_.end(); }
+  const_iterator begin() const noexcept { return data_.begin(); }
+  const_iterator end() const noexcept { return data_.end(); }
+  size_type size() const noexcept { return data_.size(); }
+  bool empty() const noexcept { return data_.empty(); }
+  void clear() noexcept { data_.clear(); }
+  void reserve(size_type count) { data_.reserve(count); }
+  allocator_type get_allocator() const { return data_.get_allocator(); }
+
+  iterator lower_bound(key_type const& key) {
+    return std::lower_bound(data_.begin(), data_.end(), key, keyLess);
+  }
+  const_iterator lower_bound(key_type const& key) const {
+    return std::lower_bound(data_.begin(), data_.end(), key, keyLess);
+  }
+  iterator find(key_type const& key) {
+    iterator it = lower_bound(key);
+    return (it != data_.end() && !Compare()(key, it->first)) ? it
+                                                              : data_.end();
+  }
+  const_iterator find(key_type const& key) const {
+    const_iterator it = lower_bound(key);
+    return (it != data_.end() && !Compare()(key, it->first)) ? it
+                                                              : data_.end();
+  }
+
+  iterator insert(const_iterator hint, value_type const& value) {
+    iterator it = position(hint, value.first);
+    if (it != data_.end() && !Compare()(value.first, it->first))
+      return it;
+    return data_.insert(it, value);
+  }
+  template <typename... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    iterator it = position(data_.end(), value.first);
+    if (it != data_.end() && !Compare()(value.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(data_.insert(it, std::move(value)), true);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    iterator it = position(hint, value.first);
+    if (it != data_.end() && !Compare()(value.first, it->first))
+      return it;
+    return data_.insert(it, std::move(value));
+  }
+  mapped_type& operator[](key_type const& key) {
+    iterator it = lower_bound(key);
+    if (it == data_.end() || Compare()(key, it->first))
+      it = data_.insert(it, value_type(key, mapped_type()));
+    return it->second;
+  }
+
+  iterator erase(iterator pos) {
+    // Rotate the erased member to the back instead of move-assigning over it:
+    // a moved-over key would not release its string.
+    auto index = pos - data_.begin();
+    std::rotate(pos, pos + 1, data_.end());
+    data_.pop_back();
+    return data_.begin() + index;
+  }
+  size_type erase(key_type const& key) {
+    iterator it = find(key);
+    if (it == data_.end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  friend bool operator==(FlatMap const& a, FlatMap const& b) {
+    return a.data_ == b.data_;
+  }
+  friend bool operator<(FlatMap const& a, FlatMap const& b) {
+    return a.data_ < b.data_;
+  }
+
+private:
+  static bool keyLess(value_type const& value, key_type const& key) {
+    return Compare()(value.first, key);
+  }
+  iterator position(const_iterator hint, key_type const& key) {
+    if (hint == data_.end() &&
+        (data_.empty() || Compare()(data_.back().first, key)))
+      return data_.end();
+    return lower_bound(key);
+  }
+
+  Storage data_;
+};
+
 /** \brief Represents a <a HREF="http://www.json.org">JSON</a> value.
  *
  * This class is a discriminated union wrapper that can represents a:
@@ -716,6 +1000,7 @@ private:
  */
 class JSON_API Value {
   friend class ValueIteratorBase;
+  friend class OurReader;
 
 public:
   using Members = std::vector<String>;
@@ -816,7 +1101,15 @@ private:
   };
 
 public:
-  typedef std::map<CZString, Value> ObjectValues;
+#if JSONCPP_FLAT_OBJECT_VALUES
+  typedef FlatMap<CZString, Value, std::less<CZString>,
+                  ArenaAllocator<std::pair<CZString, Value>>>
+      ObjectValues;
+#else
+  typedef std::map<CZString, Value, std::less<CZString>,
+                   ArenaAllocator<std::pair<const CZString, Value>>>
+      ObjectValues;
+#endif
 #endif // ifndef JSONCPP_DOC_EXCLUDE_IMPLEMENTATION
 
 public:
@@ -960,6 +1253,14 @@ public:
   /// \post type() is arrayValue
   void resize(ArrayIndex newSize);
 
+  /// \brief Reserve room for 'count' elements or members.
+  ///
+  /// Only the flat storage (JSONCPP_FLAT_OBJECT_VALUES) has a capacity; with
+  /// std::map this does nothing.
+  /// \pre type() is arrayValue, objectValue or nullValue
+  /// \post type() is unchanged
+  void reserve(ArrayIndex count);
+
   //@{
   /// Access an array element (zero based index). If the array contains less
   /// than index element, then null value are inserted in the array so that
@@ -1109,7 +1410,8 @@ public:
   iterator end();
 
   // Accessors for the [start, limit) range of bytes within the JSON text from
-  // which this value was parsed, if any.
+  // which this value was parsed, if any. The reader only records them when
+  // "trackOffsets" is set, and never with JSONCPP_COMPACT_VALUE.
   void setOffsetStart(ptrdiff_t start);
   void setOffsetLimit(ptrdiff_t limit);
   ptrdiff_t getOffsetStart() const;
@@ -1121,6 +1423,14 @@ private:
   }
   bool isAllocated() const { return bits_.allocated_; }
   void setIsAllocated(bool v) { bits_.allocated_ = v; }
+  bool isInArena() const { return bits_.arena_; }
+
+  // Arena-backed construction, used by OurReader inside an ArenaScope.
+  static Value arenaContainer(ValueType type, Arena& arena);
+  static Value arenaString(char const* begin, char const* end, Arena& arena);
+  Value& arenaMember(char const* begin, char const* end, Arena& arena);
+  // Member whose name is already stored by the caller (KeyTable).
+  Value& internedMember(char const* name, unsigned length);
 
   void initBasic(ValueType type, bool allocated = false);
   void dupPayload(const Value& other);
@@ -1153,6 +1463,8 @@ private:
     unsigned int value_type_ : 8;
     // Unless allocated_, string_ must be null-terminated.
     unsigned int allocated_ : 1;
+    // string_ or map_ lives in an Arena and must not be freed.
+    unsigned int arena_ : 1;
   } bits_;
 
   class Comments {
@@ -1170,12 +1482,14 @@ private:
     using Array = std::array<String, numberOfCommentPlacement>;
     std::unique_ptr<Array> ptr_;
   };
+#if !JSONCPP_COMPACT_VALUE
   Comments comments_;
 
   // [start, limit) byte offsets in the source JSON text from which this Value
   // was extracted.
   ptrdiff_t start_;
   ptrdiff_t limit_;
+#endif
 };
 
 template <> inline bool Value::as<bool>() const { return asBool(); }
@@ -1799,6 +2113,16 @@ public:
    * - `"skipBom": false or true`
    *   - If true, if the input starts with the Unicode byte order mark (BOM),
    *     it is skipped.
+   * - `"validateUTF8": false or true`
+   *   - If true, reject strings that are not well-formed UTF-8 (overlong
+   *     forms, surrogates and code points above U+10FFFF included).
+   * - `"trackOffsets": false or true`
+   *   - If true, every parsed Value records its [start, limit) byte range in
+   *     the input (see Value::getOffsetStart()). False skips that work.
+   * - `"iterativeParse": false or true`
+   *   - If true, `parse()` keeps open objects and arrays on a heap-allocated
+   *     stack instead of recursing, so nesting depth costs no native stack.
+   *     stackLimit still applies. Results and errors are the same.
    *
    * You can examine 'settings_` yourself to see the defaults. You can also
    * write and read them just like any JSON Value.
@@ -1834,6 +2158,46 @@ public:
   static void strictMode(Json::Value* settings);
 };
 
+/** \brief Receives the events of parseEvents() instead of a Value tree.
+ *
+ * Each callback returns true to continue or false to stop parsing at that
+ * point. String and key ranges point into a buffer owned by the reader and
+ * are only valid during the callback. The default implementations ignore the
+ * event, so a handler only overrides what it needs.
+ */
+class JSON_API ValueHandler {
+public:
+  virtual ~ValueHandler();
+  virtual bool onNull() { return true; }
+  virtual bool onBool(bool /*value*/) { return true; }
+  virtual bool onInt(LargestInt /*value*/) { return true; }
+  virtual bool onUInt(LargestUInt /*value*/) { return true; }
+  virtual bool onDouble(double /*value*/) { return true; }
+  virtual bool onString(char const* /*begin*/, char const* /*end*/) {
+    return true;
+  }
+  virtual bool onStartObject() { return true; }
+  virtual bool onKey(char const* /*begin*/, char const* /*end*/) {
+    return true;
+  }
+  virtual bool onEndObject() { return true; }
+  virtual bool onStartArray() { return true; }
+  virtual bool onEndArray() { return true; }
+};
+
+/** \brief Tokenize a document and report it to 'handler' without building
+ * Values.
+ *
+ * Uses the same settings as the CharReader built by 'builder'. Comments are
+ * skipped and "rejectDupKeys" is not checked, so memory use does not grow
+ * with the document.
+ * \return false on a syntax error (described in 'errs'). A handler that
+ * stops early is not an error: the call returns true and 'errs' is empty.
+ */
+bool JSON_API parseEvents(CharReaderBuilder const& builder,
+                          char const* beginDoc, char const* endDoc,
+                          ValueHandler& handler, String* errs);
+
 /** Consume entire stream and use its begin/end.
  * Someday we might have a real StreamReader, but for now this
  * is convenient.
@@ -2000,8 +2364,9 @@ public:
    *  infinity as "-Infinity".
    *  - "precision": int
    *  - Number of precision digits for formatting of real values.
-   *  - "precisionType": "significant"(default) or "decimal"
-   *  - Type of precision for formatting of real values.
+   *  - "precisionType": "significant"(default), "decimal" or "shortest"
+   *  - Type of precision for formatting of real values. "shortest" ignores
+   *    "precision" and writes the fewest digits that parse back exactly.
    *  - "emitUTF8": false or true
    *  - If true, outputs raw UTF8 strings instead of escaping them.
 
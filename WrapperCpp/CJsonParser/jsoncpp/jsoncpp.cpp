@@ -105,6 +105,21 @@ license you like.
 #include <clocale>
 #endif
 
+// Locale-free std::from_chars/std::to_chars for double, when the standard
+// library has them (C++17, e.g. GCC 11, MSVC 2019 16.4).
+#if !defined(JSONCPP_HAS_CHARCONV) && defined(__has_include)
+#if __has_include(<charconv>) &&                                               \
+    (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <charconv>
+#if defined(__cpp_lib_to_chars)
+#define JSONCPP_HAS_CHARCONV 1
+#endif
+#endif
+#endif
+#if !defined(JSONCPP_HAS_CHARCONV)
+#define JSONCPP_HAS_CHARCONV 0
+#endif
+
 /* This header provides common string manipulation support, such as UTF-8,
  * portable conversion from/to string...
  *
@@ -288,6 +303,27 @@ Iter fixZerosInTheEnd(Iter begin, Iter end, unsigned int precision) {
 static size_t const stackLimit_g =
     JSONCPP_DEPRECATED_STACK_LIMIT; // see readValue()
 
+// Vectorized scanning in OurReader. SSE2 is part of every x86-64 target;
+// AVX2 kernels are compiled for the target only and picked at runtime.
+// Define JSONCPP_NO_SIMD to build the scalar kernels only.
+#if !defined(JSONCPP_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSONCPP_HAS_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#define JSONCPP_HAS_AVX2 1
+#define JSONCPP_TARGET_AVX2
+#elif defined(__GNUC__) && (defined(__clang__) || __GNUC__ >= 5)
+#include <immintrin.h>
+#define JSONCPP_HAS_AVX2 1
+#define JSONCPP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#endif // if !defined(JSONCPP_NO_SIMD)
+
 namespace Json {
 
 #if __cplusplus >= 201103L || (defined(_CPPLIB_VER) && _CPPLIB_VER >= 520)
@@ -1107,11 +1143,245 @@ public:
   bool rejectDupKeys_;
   bool allowSpecialFloats_;
   bool skipBom_;
+  bool validateUTF8_;
+  bool trackOffsets_;
+  bool iterativeParse_;
   size_t stackLimit_;
 }; // OurFeatures
 
 OurFeatures OurFeatures::all() { return {}; }
 
+// Scanning kernels
+// ////////////////////////////////
+
+static inline bool isJsonSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static const char* skipWhitespaceScalar(const char* p, const char* end) {
+  while (p != end && isJsonSpace(*p))
+    ++p;
+  return p;
+}
+
+static const char* findQuoteOrEscapeScalar(const char* p, const char* end) {
+  while (p != end && *p != '"' && *p != '\\')
+    ++p;
+  return p;
+}
+
+/// Returns the end of the UTF-8 sequence starting at the non-ASCII byte \c p,
+/// or null if it is malformed, overlong, a surrogate or above U+10FFFF.
+static const char* skipUTF8Sequence(const char* p, const char* end) {
+  auto byte = [](const char* q) { return static_cast<unsigned char>(*q); };
+  unsigned int lead = byte(p);
+  size_t length;
+  unsigned int lower = 0x80;
+  unsigned int upper = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF)
+    length = 2;
+  else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    if (lead == 0xE0)
+      lower = 0xA0;
+    else if (lead == 0xED)
+      upper = 0x9F;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    if (lead == 0xF0)
+      lower = 0x90;
+    else if (lead == 0xF4)
+      upper = 0x8F;
+  } else
+    return nullptr;
+  if (static_cast<size_t>(end - p) < length)
+    return nullptr;
+  if (byte(p + 1) < lower || byte(p + 1) > upper)
+    return nullptr;
+  for (size_t i = 2; i < length; ++i) {
+    if ((byte(p + i) & 0xC0) != 0x80)
+      return nullptr;
+  }
+  return p + length;
+}
+
+#if !defined(JSONCPP_HAS_SSE2)
+static bool validateUTF8Scalar(const char* p, const char* end) {
+  while (p != end) {
+    if (static_cast<unsigned char>(*p) < 0x80)
+      ++p;
+    else if (!(p = skipUTF8Sequence(p, end)))
+      return false;
+  }
+  return true;
+}
+#endif
+
+#if defined(JSONCPP_HAS_SSE2)
+static inline unsigned int countTrailingZeros(unsigned int mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned int>(index);
+#else
+  return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+static const char* skipWhitespaceSSE2(const char* p, const char* end) {
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i ws = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+    unsigned int mask =
+        ~static_cast<unsigned int>(_mm_movemask_epi8(ws)) & 0xFFFFu;
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 16;
+  }
+  return skipWhitespaceScalar(p, end);
+}
+
+static const char* findQuoteOrEscapeSSE2(const char* p, const char* end) {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash))));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 16;
+  }
+  return findQuoteOrEscapeScalar(p, end);
+}
+
+static bool validateUTF8SSE2(const char* p, const char* end) {
+  while (p != end) {
+    if (end - p >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(chunk));
+      if (!mask) {
+        p += 16;
+        continue;
+      }
+      p += countTrailingZeros(mask);
+    } else if (static_cast<unsigned char>(*p) < 0x80) {
+      ++p;
+      continue;
+    }
+    if (!(p = skipUTF8Sequence(p, end)))
+      return false;
+  }
+  return true;
+}
+#endif // if defined(JSONCPP_HAS_SSE2)
+
+#if defined(JSONCPP_HAS_AVX2)
+JSONCPP_TARGET_AVX2
+static const char* skipWhitespaceAVX2(const char* p, const char* end) {
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i cr = _mm256_set1_epi8('\r');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  while (end - p >= 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i ws = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                        _mm256_cmpeq_epi8(chunk, tab)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr),
+                        _mm256_cmpeq_epi8(chunk, lf)));
+    unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(ws));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 32;
+  }
+  return skipWhitespaceSSE2(p, end);
+}
+
+JSONCPP_TARGET_AVX2
+static const char* findQuoteOrEscapeAVX2(const char* p, const char* end) {
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  while (end - p >= 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                        _mm256_cmpeq_epi8(chunk, backslash))));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 32;
+  }
+  return findQuoteOrEscapeSSE2(p, end);
+}
+
+JSONCPP_TARGET_AVX2
+static bool validateUTF8AVX2(const char* p, const char* end) {
+  while (end - p >= 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(chunk));
+    if (!mask) {
+      p += 32;
+      continue;
+    }
+    p += countTrailingZeros(mask);
+    if (!(p = skipUTF8Sequence(p, end)))
+      return false;
+  }
+  return validateUTF8SSE2(p, end);
+}
+
+static bool cpuSupportsAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  // AVX and OSXSAVE, then check that the OS saves the YMM state.
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    return false;
+  if ((_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif // if defined(JSONCPP_HAS_AVX2)
+
+/// Scanning primitives of OurReader, chosen once for the running CPU.
+struct ScanKernels {
+  const char* (*skipWhitespace)(const char* p, const char* end);
+  const char* (*findQuoteOrEscape)(const char* p, const char* end);
+  bool (*validateUTF8)(const char* p, const char* end);
+};
+
+static ScanKernels selectScanKernels() {
+#if defined(JSONCPP_HAS_AVX2)
+  if (cpuSupportsAVX2())
+    return {skipWhitespaceAVX2, findQuoteOrEscapeAVX2, validateUTF8AVX2};
+#endif
+#if defined(JSONCPP_HAS_SSE2)
+  return {skipWhitespaceSSE2, findQuoteOrEscapeSSE2, validateUTF8SSE2};
+#else
+  return {skipWhitespaceScalar, findQuoteOrEscapeScalar, validateUTF8Scalar};
+#endif
+}
+
+static ScanKernels const& scanKernels() {
+  static const ScanKernels kernels = selectScanKernels();
+  return kernels;
+}
+
 // Implementation of class Reader
 // ////////////////////////////////
 
@@ -1130,6 +1400,8 @@ public:
   explicit OurReader(OurFeatures const& features);
   bool parse(const char* beginDoc, const char* endDoc, Value& root,
              bool collectComments = true);
+  bool parseEvents(const char* beginDoc, const char* endDoc,
+                   ValueHandler& handler);
   String getFormattedErrorMessages() const;
   std::vector<StructuredError> getStructuredErrors() const;
 
@@ -1184,8 +1456,15 @@ private:
   bool readStringSingleQuote();
   bool readNumber(bool checkInf);
   bool readValue();
+  bool readValueIterative();
+  bool readScalar(Token& token);
+  void finishValue();
   bool readObject(Token& token);
   bool readArray(Token& token);
+  bool readValueEvents(Token& token);
+  bool readObjectEvents();
+  bool readArrayEvents();
+  bool emitEvent(bool keepGoing);
   bool decodeNumber(Token& token);
   bool decodeNumber(Token& token, Value& decoded);
   bool decodeString(Token& token);
@@ -1202,6 +1481,17 @@ private:
                           TokenType skipUntilToken);
   void skipUntilSpace();
   Value& currentValue();
+  // Member `name` of the current object, stored per keys_ and arena_.
+  Value& currentMember(const String& name);
+  // Record source offsets on the current value if "trackOffsets" is set.
+  void setOffsetStart(ptrdiff_t start) {
+    if (features_.trackOffsets_)
+      currentValue().setOffsetStart(start);
+  }
+  void setOffsetLimit(ptrdiff_t limit) {
+    if (features_.trackOffsets_)
+      currentValue().setOffsetLimit(limit);
+  }
   Char getNextChar();
   void getLocationLineAndColumn(Location location, int& line,
                                 int& column) const;
@@ -1212,9 +1502,20 @@ private:
   static String normalizeEOL(Location begin, Location end);
   static bool containsNewLine(Location begin, Location end);
 
-  using Nodes = std::stack<Value*>;
+  using Nodes = std::stack<Value*, std::vector<Value*>>;
+
+  // An open object or array of readValueIterative(). Its Value is the entry
+  // of nodes_ at the same depth.
+  struct Frame {
+    bool isObject_;
+    // The last member name read was empty (or none was read yet): '}' is
+    // then accepted without allowTrailingCommas, as in readObject().
+    bool nameEmpty_;
+    int index_;
+  };
 
   Nodes nodes_{};
+  std::vector<Frame> frames_{};
   Errors errors_{};
   String document_{};
   Location begin_ = nullptr;
@@ -1226,7 +1527,20 @@ private:
   String commentsBefore_{};
 
   OurFeatures const features_;
+  ScanKernels const& kernels_;
   bool collectComments_ = false;
+
+  // Arena of the current parse() (see ArenaScope), or null for the heap.
+  Arena* arena_ = nullptr;
+  // Name table of the current parse() (see KeyTableScope), or null.
+  KeyTable* keys_ = nullptr;
+  // Reused decoding buffer for string values and events.
+  String stringBuffer_{};
+
+  // parseEvents() state
+  ValueHandler* handler_ = nullptr;
+  bool stopped_ = false;
+  size_t eventDepth_ = 0;
 }; // OurReader
 
 // complete copy of Read impl, for OurReader
@@ -1236,17 +1550,23 @@ bool OurReader::containsNewLine(OurReader::Location begin,
   return std::any_of(begin, end, [](char b) { return b == '\n' || b == '\r'; });
 }
 
-OurReader::OurReader(OurFeatures const& features) : features_(features) {}
+OurReader::OurReader(OurFeatures const& features)
+    : features_(features), kernels_(scanKernels()) {}
 
 bool OurReader::parse(const char* beginDoc, const char* endDoc, Value& root,
                       bool collectComments) {
   if (!features_.allowComments_) {
     collectComments = false;
   }
+#if JSONCPP_COMPACT_VALUE
+  collectComments = false;
+#endif
 
   begin_ = beginDoc;
   end_ = endDoc;
   collectComments_ = collectComments;
+  arena_ = ArenaScope::current();
+  keys_ = KeyTableScope::current();
   current_ = begin_;
   lastValueEnd_ = nullptr;
   lastValue_ = nullptr;
@@ -1258,7 +1578,8 @@ bool OurReader::parse(const char* beginDoc, const char* endDoc, Value& root,
 
   // skip byte order mark if it exists at the beginning of the UTF-8 text.
   skipBom(features_.skipBom_);
-  bool successful = readValue();
+  bool successful =
+      features_.iterativeParse_ ? readValueIterative() : readValue();
   nodes_.pop();
   Token token;
   skipCommentTokens(token);
@@ -1284,6 +1605,209 @@ bool OurReader::parse(const char* beginDoc, const char* endDoc, Value& root,
   return successful;
 }
 
+bool OurReader::parseEvents(const char* beginDoc, const char* endDoc,
+                            ValueHandler& handler) {
+  begin_ = beginDoc;
+  end_ = endDoc;
+  collectComments_ = false;
+  arena_ = nullptr;
+  keys_ = nullptr;
+  current_ = begin_;
+  lastValueEnd_ = nullptr;
+  lastValue_ = nullptr;
+  commentsBefore_.clear();
+  errors_.clear();
+  while (!nodes_.empty())
+    nodes_.pop();
+  handler_ = &handler;
+  stopped_ = false;
+  eventDepth_ = 0;
+
+  skipBom(features_.skipBom_);
+  Token token;
+  skipCommentTokens(token);
+  if (features_.strictRoot_ && token.type_ != tokenObjectBegin &&
+      token.type_ != tokenArrayBegin) {
+    handler_ = nullptr;
+    token.type_ = tokenError;
+    token.start_ = beginDoc;
+    token.end_ = endDoc;
+    return addError(
+        "A valid JSON document must be either an array or an object value.",
+        token);
+  }
+  bool successful = readValueEvents(token);
+  handler_ = nullptr;
+  if (stopped_)
+    return true;
+  if (!successful)
+    return false;
+  skipCommentTokens(token);
+  if (features_.failIfExtra_ && (token.type_ != tokenEndOfStream)) {
+    addError("Extra non-whitespace after JSON value.", token);
+    return false;
+  }
+  return true;
+}
+
+bool OurReader::emitEvent(bool keepGoing) {
+  if (!keepGoing)
+    stopped_ = true;
+  return keepGoing;
+}
+
+bool OurReader::readValueEvents(Token& token) {
+  if (eventDepth_ > features_.stackLimit_)
+    throwRuntimeError("Exceeded stackLimit in readValueEvents().");
+  switch (token.type_) {
+  case tokenObjectBegin: {
+    ++eventDepth_;
+    bool ok = emitEvent(handler_->onStartObject()) && readObjectEvents();
+    --eventDepth_;
+    return ok;
+  }
+  case tokenArrayBegin: {
+    ++eventDepth_;
+    bool ok = emitEvent(handler_->onStartArray()) && readArrayEvents();
+    --eventDepth_;
+    return ok;
+  }
+  case tokenNumber: {
+    Value decoded;
+    if (!decodeNumber(token, decoded))
+      return false;
+    if (decoded.type() == intValue)
+      return emitEvent(handler_->onInt(decoded.asLargestInt()));
+    if (decoded.type() == uintValue)
+      return emitEvent(handler_->onUInt(decoded.asLargestUInt()));
+    return emitEvent(handler_->onDouble(decoded.asDouble()));
+  }
+  case tokenString:
+    stringBuffer_.clear();
+    if (!decodeString(token, stringBuffer_))
+      return false;
+    return emitEvent(handler_->onString(
+        stringBuffer_.data(), stringBuffer_.data() + stringBuffer_.size()));
+  case tokenTrue:
+    return emitEvent(handler_->onBool(true));
+  case tokenFalse:
+    return emitEvent(handler_->onBool(false));
+  case tokenNull:
+    return emitEvent(handler_->onNull());
+  case tokenNaN:
+    return emitEvent(
+        handler_->onDouble(std::numeric_limits<double>::quiet_NaN()));
+  case tokenPosInf:
+    return emitEvent(
+        handler_->onDouble(std::numeric_limits<double>::infinity()));
+  case tokenNegInf:
+    return emitEvent(
+        handler_->onDouble(-std::numeric_limits<double>::infinity()));
+  case tokenArraySeparator:
+  case tokenObjectEnd:
+  case tokenArrayEnd:
+    if (features_.allowDroppedNullPlaceholders_) {
+      // "Un-read" the current token and report a null value.
+      current_--;
+      return emitEvent(handler_->onNull());
+    } // else, fall through ...
+  default:
+    return addError("Syntax error: value, object or array expected.", token);
+  }
+}
+
+bool OurReader::readObjectEvents() {
+  Token tokenName;
+  bool empty = true;
+  while (readToken(tokenName)) {
+    bool initialTokenOk = true;
+    while (tokenName.type_ == tokenComment && initialTokenOk)
+      initialTokenOk = readToken(tokenName);
+    if (!initialTokenOk)
+      break;
+    if (tokenName.type_ == tokenObjectEnd &&
+        (empty || features_.allowTrailingCommas_)) // empty object or trailing
+                                                   // comma
+      return emitEvent(handler_->onEndObject());
+    stringBuffer_.clear();
+    if (tokenName.type_ == tokenString) {
+      if (!decodeString(tokenName, stringBuffer_))
+        return false;
+    } else if (tokenName.type_ == tokenNumber && features_.allowNumericKeys_) {
+      Value numberName;
+      if (!decodeNumber(tokenName, numberName))
+        return false;
+      stringBuffer_ = numberName.asString();
+    } else {
+      break;
+    }
+    if (stringBuffer_.length() >= (1U << 30))
+      throwRuntimeError("keylength >= 2^30");
+    empty = false;
+
+    Token colon;
+    if (!readToken(colon) || colon.type_ != tokenMemberSeparator)
+      return addError("Missing ':' after object member name", colon);
+    if (!emitEvent(handler_->onKey(stringBuffer_.data(),
+                                   stringBuffer_.data() + stringBuffer_.size())))
+      return false;
+    Token valueToken;
+    skipCommentTokens(valueToken);
+    if (!readValueEvents(valueToken))
+      return false;
+
+    Token comma;
+    if (!readToken(comma) ||
+        (comma.type_ != tokenObjectEnd && comma.type_ != tokenArraySeparator &&
+         comma.type_ != tokenComment)) {
+      return addError("Missing ',' or '}' in object declaration", comma);
+    }
+    bool finalizeTokenOk = true;
+    while (comma.type_ == tokenComment && finalizeTokenOk)
+      finalizeTokenOk = readToken(comma);
+    if (comma.type_ == tokenObjectEnd)
+      return emitEvent(handler_->onEndObject());
+  }
+  return addError("Missing '}' or object member name", tokenName);
+}
+
+bool OurReader::readArrayEvents() {
+  int index = 0;
+  for (;;) {
+    skipSpaces();
+    if (current_ != end_ && *current_ == ']' &&
+        (index == 0 ||
+         (features_.allowTrailingCommas_ &&
+          !features_.allowDroppedNullPlaceholders_))) // empty array or trailing
+                                                      // comma
+    {
+      Token endArray;
+      readToken(endArray);
+      return emitEvent(handler_->onEndArray());
+    }
+    ++index;
+    Token valueToken;
+    skipCommentTokens(valueToken);
+    if (!readValueEvents(valueToken))
+      return false;
+
+    Token currentToken;
+    // Accept Comment after last item in the array.
+    bool ok = readToken(currentToken);
+    while (currentToken.type_ == tokenComment && ok) {
+      ok = readToken(currentToken);
+    }
+    bool badTokenType = (currentToken.type_ != tokenArraySeparator &&
+                         currentToken.type_ != tokenArrayEnd);
+    if (!ok || badTokenType) {
+      return addError("Missing ',' or ']' in array declaration",
+                      currentToken);
+    }
+    if (currentToken.type_ == tokenArrayEnd)
+      return emitEvent(handler_->onEndArray());
+  }
+}
+
 bool OurReader::readValue() {
   //  To preserve the old behaviour we cast size_t to int.
   if (nodes_.size() > features_.stackLimit_)
@@ -1300,12 +1824,23 @@ bool OurReader::readValue() {
   switch (token.type_) {
   case tokenObjectBegin:
     successful = readObject(token);
-    currentValue().setOffsetLimit(current_ - begin_);
+    setOffsetLimit(current_ - begin_);
     break;
   case tokenArrayBegin:
     successful = readArray(token);
-    currentValue().setOffsetLimit(current_ - begin_);
+    setOffsetLimit(current_ - begin_);
     break;
+  default:
+    return readScalar(token);
+  }
+
+  finishValue();
+  return successful;
+}
+
+bool OurReader::readScalar(Token& token) {
+  bool successful = true;
+  switch (token.type_) {
   case tokenNumber:
     successful = decodeNumber(token);
     break;
@@ -1315,38 +1850,38 @@ bool OurReader::readValue() {
   case tokenTrue: {
     Value v(true);
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenFalse: {
     Value v(false);
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenNull: {
     Value v;
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenNaN: {
     Value v(std::numeric_limits<double>::quiet_NaN());
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenPosInf: {
     Value v(std::numeric_limits<double>::infinity());
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenNegInf: {
     Value v(-std::numeric_limits<double>::infinity());
     currentValue().swapPayload(v);
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
   } break;
   case tokenArraySeparator:
   case tokenObjectEnd:
@@ -1357,23 +1892,182 @@ bool OurReader::readValue() {
       current_--;
       Value v;
       currentValue().swapPayload(v);
-      currentValue().setOffsetStart(current_ - begin_ - 1);
-      currentValue().setOffsetLimit(current_ - begin_);
+      setOffsetStart(current_ - begin_ - 1);
+      setOffsetLimit(current_ - begin_);
       break;
     } // else, fall through ...
   default:
-    currentValue().setOffsetStart(token.start_ - begin_);
-    currentValue().setOffsetLimit(token.end_ - begin_);
+    setOffsetStart(token.start_ - begin_);
+    setOffsetLimit(token.end_ - begin_);
     return addError("Syntax error: value, object or array expected.", token);
   }
 
+  finishValue();
+  return successful;
+}
+
+void OurReader::finishValue() {
   if (collectComments_) {
     lastValueEnd_ = current_;
     lastValueHasAComment_ = false;
     lastValue_ = &currentValue();
   }
+}
 
-  return successful;
+// Same grammar, error recovery and comment placement as readValue(), with the
+// open containers kept in frames_ instead of on the native stack.
+bool OurReader::readValueIterative() {
+  frames_.clear();
+  String name;
+  for (;;) {
+    // Read the value at the top of nodes_.
+    if (nodes_.size() > features_.stackLimit_)
+      throwRuntimeError("Exceeded stackLimit in readValue().");
+    Token token;
+    skipCommentTokens(token);
+    if (collectComments_ && !commentsBefore_.empty()) {
+      currentValue().setComment(commentsBefore_, commentBefore);
+      commentsBefore_.clear();
+    }
+    bool successful = true;
+    // Set when the top container was just opened or a ',' was read in it.
+    bool wantMember = false;
+    if (token.type_ == tokenObjectBegin || token.type_ == tokenArrayBegin) {
+      const bool isObject = token.type_ == tokenObjectBegin;
+      const ValueType type = isObject ? objectValue : arrayValue;
+      Value init = arena_ ? Value::arenaContainer(type, *arena_) : Value(type);
+      currentValue().swapPayload(init);
+      setOffsetStart(token.start_ - begin_);
+      frames_.push_back(Frame{isObject, true, 0});
+      wantMember = true;
+    } else if (!readScalar(token)) {
+      successful = false;
+    }
+
+    // Close containers until one of them expects another member.
+    while (successful) {
+      if (frames_.empty())
+        return true;
+      Frame& frame = frames_.back();
+      bool close = false;
+      if (!wantMember) {
+        // The member at the top of nodes_ is complete: read the separator.
+        if (nodes_.size() > frames_.size())
+          nodes_.pop();
+        Token separator;
+        if (frame.isObject_) {
+          if (!readToken(separator) ||
+              (separator.type_ != tokenObjectEnd &&
+               separator.type_ != tokenArraySeparator &&
+               separator.type_ != tokenComment)) {
+            successful = addError("Missing ',' or '}' in object declaration",
+                                  separator);
+            break;
+          }
+          bool finalizeTokenOk = true;
+          while (separator.type_ == tokenComment && finalizeTokenOk)
+            finalizeTokenOk = readToken(separator);
+          close = separator.type_ == tokenObjectEnd;
+        } else {
+          // Accept Comment after last item in the array.
+          bool ok = readToken(separator);
+          while (separator.type_ == tokenComment && ok)
+            ok = readToken(separator);
+          if (!ok || (separator.type_ != tokenArraySeparator &&
+                      separator.type_ != tokenArrayEnd)) {
+            successful = addError("Missing ',' or ']' in array declaration",
+                                  separator);
+            break;
+          }
+          close = separator.type_ == tokenArrayEnd;
+        }
+      } else if (frame.isObject_) {
+        Token tokenName;
+        bool ok = readToken(tokenName);
+        while (ok && tokenName.type_ == tokenComment)
+          ok = readToken(tokenName);
+        if (ok && tokenName.type_ == tokenObjectEnd &&
+            (frame.nameEmpty_ || features_.allowTrailingCommas_)) {
+          close = true;
+        } else {
+          name.clear();
+          if (ok && tokenName.type_ == tokenString) {
+            if (!decodeString(tokenName, name)) {
+              successful = false;
+              break;
+            }
+          } else if (ok && tokenName.type_ == tokenNumber &&
+                     features_.allowNumericKeys_) {
+            Value numberName;
+            if (!decodeNumber(tokenName, numberName)) {
+              successful = false;
+              break;
+            }
+            name = numberName.asString();
+          } else {
+            successful =
+                addError("Missing '}' or object member name", tokenName);
+            break;
+          }
+          if (name.length() >= (1U << 30))
+            throwRuntimeError("keylength >= 2^30");
+          if (features_.rejectDupKeys_ && currentValue().isMember(name)) {
+            successful =
+                addError("Duplicate key: '" + name + "'", tokenName);
+            break;
+          }
+          Token colon;
+          if (!readToken(colon) || colon.type_ != tokenMemberSeparator) {
+            successful =
+                addError("Missing ':' after object member name", colon);
+            break;
+          }
+          frame.nameEmpty_ = name.empty();
+          Value& value = currentMember(name);
+          nodes_.push(&value);
+          break;
+        }
+      } else {
+        skipSpaces();
+        if (current_ != end_ && *current_ == ']' &&
+            (frame.index_ == 0 ||
+             (features_.allowTrailingCommas_ &&
+              !features_.allowDroppedNullPlaceholders_))) {
+          Token endArray;
+          readToken(endArray);
+          close = true;
+        } else {
+          nodes_.push(&currentValue()[frame.index_++]);
+          break;
+        }
+      }
+      if (close) {
+        setOffsetLimit(current_ - begin_);
+        finishValue();
+        frames_.pop_back();
+        wantMember = false;
+      } else {
+        wantMember = !wantMember;
+      }
+    }
+    if (successful)
+      continue;
+
+    // Unwind like the recursive reader: each open container skips to its
+    // closing token, innermost first.
+    if (!frames_.empty() && nodes_.size() > frames_.size())
+      nodes_.pop();
+    while (!frames_.empty()) {
+      recoverFromError(frames_.back().isObject_ ? tokenObjectEnd
+                                                : tokenArrayEnd);
+      setOffsetLimit(current_ - begin_);
+      finishValue();
+      frames_.pop_back();
+      if (!frames_.empty())
+        nodes_.pop();
+    }
+    return false;
+  }
 }
 
 void OurReader::skipCommentTokens(Token& token) {
@@ -1498,13 +2192,13 @@ bool OurReader::readToken(Token& token) {
 }
 
 void OurReader::skipSpaces() {
-  while (current_ != end_) {
-    Char c = *current_;
-    if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
-      ++current_;
-    else
-      break;
-  }
+  // Most tokens are followed by at most one space; only longer runs such as
+  // indentation are worth handing to the vector kernel.
+  if (current_ == end_ || !isJsonSpace(*current_))
+    return;
+  ++current_;
+  if (current_ != end_ && isJsonSpace(*current_))
+    current_ = kernels_.skipWhitespace(current_, end_);
 }
 
 void OurReader::skipBom(bool skipBom) {
@@ -1651,15 +2345,16 @@ bool OurReader::readNumber(bool checkInf) {
   return true;
 }
 bool OurReader::readString() {
-  Char c = 0;
   while (current_ != end_) {
-    c = getNextChar();
-    if (c == '\\')
-      getNextChar();
-    else if (c == '"')
+    current_ = kernels_.findQuoteOrEscape(current_, end_);
+    if (current_ == end_)
       break;
+    if (*current_++ == '"')
+      return true;
+    if (current_ != end_) // skip the escaped character
+      ++current_;
   }
-  return c == '"';
+  return false;
 }
 
 bool OurReader::readStringSingleQuote() {
@@ -1677,9 +2372,10 @@ bool OurReader::readStringSingleQuote() {
 bool OurReader::readObject(Token& token) {
   Token tokenName;
   String name;
-  Value init(objectValue);
+  Value init = arena_ ? Value::arenaContainer(objectValue, *arena_)
+                      : Value(objectValue);
   currentValue().swapPayload(init);
-  currentValue().setOffsetStart(token.start_ - begin_);
+  setOffsetStart(token.start_ - begin_);
   while (readToken(tokenName)) {
     bool initialTokenOk = true;
     while (tokenName.type_ == tokenComment && initialTokenOk)
@@ -1714,7 +2410,7 @@ bool OurReader::readObject(Token& token) {
       return addErrorAndRecover("Missing ':' after object member name", colon,
                                 tokenObjectEnd);
     }
-    Value& value = currentValue()[name];
+    Value& value = currentMember(name);
     nodes_.push(&value);
     bool ok = readValue();
     nodes_.pop();
@@ -1739,9 +2435,10 @@ bool OurReader::readObject(Token& token) {
 }
 
 bool OurReader::readArray(Token& token) {
-  Value init(arrayValue);
+  Value init = arena_ ? Value::arenaContainer(arrayValue, *arena_)
+                      : Value(arrayValue);
   currentValue().swapPayload(init);
-  currentValue().setOffsetStart(token.start_ - begin_);
+  setOffsetStart(token.start_ - begin_);
   int index = 0;
   for (;;) {
     skipSpaces();
@@ -1785,8 +2482,8 @@ bool OurReader::decodeNumber(Token& token) {
   if (!decodeNumber(token, decoded))
     return false;
   currentValue().swapPayload(decoded);
-  currentValue().setOffsetStart(token.start_ - begin_);
-  currentValue().setOffsetLimit(token.end_ - begin_);
+  setOffsetStart(token.start_ - begin_);
+  setOffsetLimit(token.end_ - begin_);
   return true;
 }
 
@@ -1875,13 +2572,23 @@ bool OurReader::decodeDouble(Token& token) {
   if (!decodeDouble(token, decoded))
     return false;
   currentValue().swapPayload(decoded);
-  currentValue().setOffsetStart(token.start_ - begin_);
-  currentValue().setOffsetLimit(token.end_ - begin_);
+  setOffsetStart(token.start_ - begin_);
+  setOffsetLimit(token.end_ - begin_);
   return true;
 }
 
 bool OurReader::decodeDouble(Token& token, Value& decoded) {
   double value = 0;
+#if JSONCPP_HAS_CHARCONV
+  // Exact and locale-free. Anything from_chars does not take whole (such as
+  // "1." or out-of-range values) goes through the stream below as before.
+  std::from_chars_result result =
+      std::from_chars(token.start_, token.end_, value);
+  if (result.ec == std::errc() && result.ptr == token.end_) {
+    decoded = value;
+    return true;
+  }
+#endif
   const String buffer(token.start_, token.end_);
   IStringStream is(buffer);
   if (!(is >> value)) {
@@ -1893,13 +2600,16 @@ bool OurReader::decodeDouble(Token& token, Value& decoded) {
 }
 
 bool OurReader::decodeString(Token& token) {
-  String decoded_string;
-  if (!decodeString(token, decoded_string))
+  stringBuffer_.clear();
+  if (!decodeString(token, stringBuffer_))
     return false;
-  Value decoded(decoded_string);
+  const char* data = stringBuffer_.data();
+  Value decoded = arena_ ? Value::arenaString(data, data + stringBuffer_.size(),
+                                              *arena_)
+                         : Value(data, data + stringBuffer_.size());
   currentValue().swapPayload(decoded);
-  currentValue().setOffsetStart(token.start_ - begin_);
-  currentValue().setOffsetLimit(token.end_ - begin_);
+  setOffsetStart(token.start_ - begin_);
+  setOffsetLimit(token.end_ - begin_);
   return true;
 }
 
@@ -1907,7 +2617,15 @@ bool OurReader::decodeString(Token& token, String& decoded) {
   decoded.reserve(static_cast<size_t>(token.end_ - token.start_ - 2));
   Location current = token.start_ + 1; // skip '"'
   Location end = token.end_ - 1;       // do not include '"'
+  if (features_.validateUTF8_ && !kernels_.validateUTF8(current, end))
+    return addError("Invalid UTF-8 sequence in string", token);
   while (current != end) {
+    // Copy the run up to the next escape (or stray quote) in one go.
+    Location run = kernels_.findQuoteOrEscape(current, end);
+    decoded.append(current, run);
+    current = run;
+    if (current == end)
+      break;
     Char c = *current++;
     if (c == '"')
       break;
@@ -1949,8 +2667,6 @@ bool OurReader::decodeString(Token& token, String& decoded) {
       default:
         return addError("Bad escape sequence in string", token, current);
       }
-    } else {
-      decoded += c;
     }
   }
   return true;
@@ -2037,6 +2753,17 @@ bool OurReader::addErrorAndRecover(const String& message, Token& token,
 
 Value& OurReader::currentValue() { return *(nodes_.top()); }
 
+Value& OurReader::currentMember(const String& name) {
+  const char* begin = name.data();
+  const char* end = begin + name.size();
+  if (keys_)
+    return currentValue().internedMember(keys_->intern(begin, end),
+                                         static_cast<unsigned>(name.size()));
+  if (arena_)
+    return currentValue().arenaMember(begin, end, *arena_);
+  return currentValue()[name];
+}
+
 OurReader::Char OurReader::getNextChar() {
   if (current_ == end_)
     return 0;
@@ -2115,27 +2842,34 @@ public:
   }
 };
 
-CharReaderBuilder::CharReaderBuilder() { setDefaults(&settings_); }
-CharReaderBuilder::~CharReaderBuilder() = default;
-CharReader* CharReaderBuilder::newCharReader() const {
-  bool collectComments = settings_["collectComments"].asBool();
+static OurFeatures featuresFromSettings(Value const& settings) {
   OurFeatures features = OurFeatures::all();
-  features.allowComments_ = settings_["allowComments"].asBool();
-  features.allowTrailingCommas_ = settings_["allowTrailingCommas"].asBool();
-  features.strictRoot_ = settings_["strictRoot"].asBool();
+  features.allowComments_ = settings["allowComments"].asBool();
+  features.allowTrailingCommas_ = settings["allowTrailingCommas"].asBool();
+  features.strictRoot_ = settings["strictRoot"].asBool();
   features.allowDroppedNullPlaceholders_ =
-      settings_["allowDroppedNullPlaceholders"].asBool();
-  features.allowNumericKeys_ = settings_["allowNumericKeys"].asBool();
-  features.allowSingleQuotes_ = settings_["allowSingleQuotes"].asBool();
+      settings["allowDroppedNullPlaceholders"].asBool();
+  features.allowNumericKeys_ = settings["allowNumericKeys"].asBool();
+  features.allowSingleQuotes_ = settings["allowSingleQuotes"].asBool();
 
   // Stack limit is always a size_t, so we get this as an unsigned int
   // regardless of it we have 64-bit integer support enabled.
-  features.stackLimit_ = static_cast<size_t>(settings_["stackLimit"].asUInt());
-  features.failIfExtra_ = settings_["failIfExtra"].asBool();
-  features.rejectDupKeys_ = settings_["rejectDupKeys"].asBool();
-  features.allowSpecialFloats_ = settings_["allowSpecialFloats"].asBool();
-  features.skipBom_ = settings_["skipBom"].asBool();
-  return new OurCharReader(collectComments, features);
+  features.stackLimit_ = static_cast<size_t>(settings["stackLimit"].asUInt());
+  features.failIfExtra_ = settings["failIfExtra"].asBool();
+  features.rejectDupKeys_ = settings["rejectDupKeys"].asBool();
+  features.allowSpecialFloats_ = settings["allowSpecialFloats"].asBool();
+  features.skipBom_ = settings["skipBom"].asBool();
+  features.validateUTF8_ = settings["validateUTF8"].asBool();
+  features.trackOffsets_ = settings["trackOffsets"].asBool();
+  features.iterativeParse_ = settings["iterativeParse"].asBool();
+  return features;
+}
+
+CharReaderBuilder::CharReaderBuilder() { setDefaults(&settings_); }
+CharReaderBuilder::~CharReaderBuilder() = default;
+CharReader* CharReaderBuilder::newCharReader() const {
+  bool collectComments = settings_["collectComments"].asBool();
+  return new OurCharReader(collectComments, featuresFromSettings(settings_));
 }
 
 bool CharReaderBuilder::validate(Json::Value* invalid) const {
@@ -2152,6 +2886,9 @@ bool CharReaderBuilder::validate(Json::Value* invalid) const {
       "rejectDupKeys",
       "allowSpecialFloats",
       "skipBom",
+      "validateUTF8",
+      "trackOffsets",
+      "iterativeParse",
   };
   for (auto si = settings_.begin(); si != settings_.end(); ++si) {
     auto key = si.name();
@@ -2182,6 +2919,9 @@ void CharReaderBuilder::strictMode(Json::Value* settings) {
   (*settings)["rejectDupKeys"] = true;
   (*settings)["allowSpecialFloats"] = false;
   (*settings)["skipBom"] = true;
+  (*settings)["validateUTF8"] = false;
+  (*settings)["trackOffsets"] = true;
+  (*settings)["iterativeParse"] = false;
   //! [CharReaderBuilderStrictMode]
 }
 // static
@@ -2199,12 +2939,27 @@ void CharReaderBuilder::setDefaults(Json::Value* settings) {
   (*settings)["rejectDupKeys"] = false;
   (*settings)["allowSpecialFloats"] = false;
   (*settings)["skipBom"] = true;
+  (*settings)["validateUTF8"] = false;
+  (*settings)["trackOffsets"] = true;
+  (*settings)["iterativeParse"] = false;
   //! [CharReaderBuilderDefaults]
 }
 
 //////////////////////////////////
 // global functions
 
+ValueHandler::~ValueHandler() = default;
+
+bool parseEvents(CharReaderBuilder const& builder, char const* beginDoc,
+                 char const* endDoc, ValueHandler& handler, String* errs) {
+  OurReader reader(featuresFromSettings(builder.settings_));
+  bool ok = reader.parseEvents(beginDoc, endDoc, handler);
+  if (errs) {
+    *errs = reader.getFormattedErrorMessages();
+  }
+  return ok;
+}
+
 bool parseFromStream(CharReader::Factory const& fact, IStream& sin, Value* root,
                      String* errs) {
   OStringStream ssin;
@@ -2309,7 +3064,7 @@ void ValueIteratorBase::copy(const SelfType& other) {
 }
 
 Value ValueIteratorBase::key() const {
-  const Value::CZString czstring = (*current_).first;
+  const Value::CZString& czstring = (*current_).first;
   if (czstring.data()) {
     if (czstring.isStaticString())
       return Value(StaticString(czstring.data()));
@@ -2319,7 +3074,7 @@ Value ValueIteratorBase::key() const {
 }
 
 UInt ValueIteratorBase::index() const {
-  const Value::CZString czstring = (*current_).first;
+  const Value::CZString& czstring = (*current_).first;
   if (!czstring.data())
     return czstring.index();
   return Value::UInt(-1);
@@ -2636,6 +3391,148 @@ JSONCPP_NORETURN void throwLogicError(String const& msg) {
 }
 #endif
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class Arena
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+static thread_local Arena* currentArena = nullptr;
+
+Arena::Arena(size_t blockSize) : blockSize_(blockSize) {}
+
+Arena::~Arena() { release(); }
+
+Arena::Block* Arena::newBlock(size_t size) {
+  auto block = static_cast<Block*>(malloc(sizeof(Block) + size));
+  if (block == nullptr) {
+    throwRuntimeError("in Json::Arena::allocate(): "
+                      "Failed to allocate arena block");
+  }
+  block->size_ = size;
+  capacity_ += size;
+  return block;
+}
+
+void* Arena::allocate(size_t size, size_t align) {
+  auto aligned = [align](char* p) {
+    auto address = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<char*>((address + align - 1) & ~(align - 1));
+  };
+  char* result = current_ ? aligned(current_) : nullptr;
+  if (result && size <= static_cast<size_t>(end_ - result)) {
+    current_ = result + size;
+    return result;
+  }
+  if (size + align > blockSize_ / 4) {
+    // Large requests get a block of their own behind the current one, so
+    // the free tail of the current block stays usable.
+    Block* block = newBlock(size + align);
+    if (head_) {
+      block->next_ = head_->next_;
+      head_->next_ = block;
+    } else {
+      block->next_ = nullptr;
+      head_ = block;
+    }
+    return aligned(reinterpret_cast<char*>(block + 1));
+  }
+  Block* block = newBlock(blockSize_);
+  block->next_ = head_;
+  head_ = block;
+  current_ = reinterpret_cast<char*>(block + 1);
+  end_ = current_ + blockSize_;
+  result = aligned(current_);
+  current_ = result + size;
+  return result;
+}
+
+void Arena::release() {
+  while (head_) {
+    Block* next = head_->next_;
+    free(head_);
+    head_ = next;
+  }
+  current_ = end_ = nullptr;
+  capacity_ = 0;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous_(currentArena) {
+  currentArena = arena;
+}
+
+ArenaScope::~ArenaScope() { currentArena = previous_; }
+
+Arena* ArenaScope::current() { return currentArena; }
+
+static thread_local KeyTable* currentKeyTable = nullptr;
+
+KeyTable::KeyTable() : names_(16 * 1024), slots_(64) {}
+
+KeyTable::~KeyTable() = default;
+
+// FNV-1a; member names are short, so this is cheaper than anything smarter.
+unsigned KeyTable::hash(const char* begin, const char* end) {
+  unsigned h = 2166136261U;
+  for (; begin != end; ++begin)
+    h = (h ^ static_cast<unsigned char>(*begin)) * 16777619U;
+  return h;
+}
+
+const KeyTable::Slot* KeyTable::lookup(const char* begin, unsigned length,
+                                       unsigned hash) const {
+  size_t mask = slots_.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    const Slot& slot = slots_[i];
+    if (!slot.name_ || (slot.hash_ == hash && slot.length_ == length &&
+                        memcmp(slot.name_, begin, length) == 0))
+      return &slot;
+  }
+}
+
+void KeyTable::grow() {
+  std::vector<Slot> old(slots_.size() * 2);
+  old.swap(slots_);
+  size_t mask = slots_.size() - 1;
+  for (const Slot& slot : old) {
+    if (!slot.name_)
+      continue;
+    size_t i = slot.hash_ & mask;
+    while (slots_[i].name_)
+      i = (i + 1) & mask;
+    slots_[i] = slot;
+  }
+}
+
+const char* KeyTable::intern(const char* begin, const char* end) {
+  auto length = static_cast<unsigned>(end - begin);
+  unsigned h = hash(begin, end);
+  auto slot = const_cast<Slot*>(lookup(begin, length, h));
+  if (slot->name_)
+    return slot->name_;
+  // Keep the load factor at or below one half.
+  if ((size_ + 1) * 2 > slots_.size()) {
+    grow();
+    slot = const_cast<Slot*>(lookup(begin, length, h));
+  }
+  auto name = static_cast<char*>(names_.allocate(length + 1U, 1));
+  memcpy(name, begin, length);
+  name[length] = 0;
+  *slot = Slot{name, length, h};
+  ++size_;
+  return name;
+}
+
+KeyTableScope::KeyTableScope(KeyTable* keys) : previous_(currentKeyTable) {
+  currentKeyTable = keys;
+}
+
+KeyTableScope::~KeyTableScope() { currentKeyTable = previous_; }
+
+KeyTable* KeyTableScope::current() { return currentKeyTable; }
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -2713,6 +3610,9 @@ bool Value::CZString::operator<(const CZString& other) const {
   // Assume both are strings.
   unsigned this_len = this->storage_.length_;
   unsigned other_len = other.storage_.length_;
+  // Names interned by a KeyTable are equal exactly when the pointers are.
+  if (cstr_ == other.cstr_)
+    return this_len < other_len;
   unsigned min_len = std::min<unsigned>(this_len, other_len);
   JSON_ASSERT(this->cstr_ && other.cstr_);
   int comp = memcmp(this->cstr_, other.cstr_, min_len);
@@ -2732,6 +3632,8 @@ bool Value::CZString::operator==(const CZString& other) const {
   unsigned other_len = other.storage_.length_;
   if (this_len != other_len)
     return false;
+  if (cstr_ == other.cstr_)
+    return true;
   JSON_ASSERT(this->cstr_ && other.cstr_);
   int comp = memcmp(this->cstr_, other.cstr_, this_len);
   return comp == 0;
@@ -2879,9 +3781,11 @@ void Value::copyPayload(const Value& other) {
 
 void Value::swap(Value& other) {
   swapPayload(other);
+#if !JSONCPP_COMPACT_VALUE
   std::swap(comments_, other.comments_);
   std::swap(start_, other.start_);
   std::swap(limit_, other.limit_);
+#endif
 }
 
 void Value::copy(const Value& other) {
@@ -3305,8 +4209,10 @@ void Value::clear() {
   JSON_ASSERT_MESSAGE(type() == nullValue || type() == arrayValue ||
                           type() == objectValue,
                       "in Json::Value::clear(): requires complex value");
+#if !JSONCPP_COMPACT_VALUE
   start_ = 0;
   limit_ = 0;
+#endif
   switch (type()) {
   case arrayValue:
   case objectValue:
@@ -3336,6 +4242,18 @@ void Value::resize(ArrayIndex newSize) {
   }
 }
 
+void Value::reserve(ArrayIndex count) {
+  JSON_ASSERT_MESSAGE(type() == nullValue || type() == arrayValue ||
+                          type() == objectValue,
+                      "in Json::Value::reserve(): requires complex value");
+#if JSONCPP_FLAT_OBJECT_VALUES
+  if (type() != nullValue)
+    value_.map_->reserve(count);
+#else
+  (void)count;
+#endif
+}
+
 Value& Value::operator[](ArrayIndex index) {
   JSON_ASSERT_MESSAGE(
       type() == nullValue || type() == arrayValue,
@@ -3382,14 +4300,18 @@ const Value& Value::operator[](int index) const {
 void Value::initBasic(ValueType type, bool allocated) {
   setType(type);
   setIsAllocated(allocated);
+  bits_.arena_ = false;
+#if !JSONCPP_COMPACT_VALUE
   comments_ = Comments{};
   start_ = 0;
   limit_ = 0;
+#endif
 }
 
 void Value::dupPayload(const Value& other) {
   setType(other.type());
   setIsAllocated(false);
+  bits_.arena_ = false;
   switch (type()) {
   case nullValue:
   case intValue:
@@ -3428,22 +4350,87 @@ void Value::releasePayload() {
   case booleanValue:
     break;
   case stringValue:
-    if (isAllocated())
+    if (isAllocated() && !isInArena())
       releasePrefixedStringValue(value_.string_);
     break;
   case arrayValue:
   case objectValue:
-    delete value_.map_;
+    if (isInArena())
+      value_.map_->~ObjectValues();
+    else
+      delete value_.map_;
     break;
   default:
     JSON_ASSERT_UNREACHABLE;
   }
 }
 
+Value Value::arenaContainer(ValueType type, Arena& arena) {
+  JSON_ASSERT(type == arrayValue || type == objectValue);
+  Value value;
+  value.setType(type);
+  value.bits_.arena_ = true;
+  value.value_.map_ = new (arena.allocate(sizeof(ObjectValues),
+                                          alignof(ObjectValues)))
+      ObjectValues(ObjectValues::allocator_type(&arena));
+  return value;
+}
+
+Value Value::arenaString(char const* begin, char const* end, Arena& arena) {
+  auto length = static_cast<unsigned>(end - begin);
+  auto prefixed = static_cast<char*>(
+      arena.allocate(sizeof(unsigned) + length + 1U, alignof(unsigned)));
+  *reinterpret_cast<unsigned*>(prefixed) = length;
+  memcpy(prefixed + sizeof(unsigned), begin, length);
+  prefixed[sizeof(unsigned) + length] = 0;
+  Value value;
+  value.setType(stringValue);
+  value.setIsAllocated(true);
+  value.bits_.arena_ = true;
+  value.value_.string_ = prefixed;
+  return value;
+}
+
+// Like resolveReference(key, end), but a new member name is stored in the
+// arena. duplicateOnCopy makes copies of the key independent of the arena.
+Value& Value::arenaMember(char const* begin, char const* end, Arena& arena) {
+  JSON_ASSERT(type() == objectValue);
+  auto length = static_cast<unsigned>(end - begin);
+  CZString lookup(begin, length, CZString::noDuplication);
+  auto it = value_.map_->lower_bound(lookup);
+  if (it != value_.map_->end() && (*it).first == lookup)
+    return (*it).second;
+  auto name = static_cast<char*>(arena.allocate(length + 1U, 1));
+  memcpy(name, begin, length);
+  name[length] = 0;
+  it = value_.map_->emplace_hint(
+      it, std::piecewise_construct,
+      std::forward_as_tuple(name, length, CZString::duplicateOnCopy),
+      std::forward_as_tuple());
+  return (*it).second;
+}
+
+// Like arenaMember(), but the name is already stored by a KeyTable.
+Value& Value::internedMember(char const* name, unsigned length) {
+  JSON_ASSERT(type() == objectValue);
+  CZString key(name, length, CZString::duplicateOnCopy);
+  auto it = value_.map_->lower_bound(key);
+  if (it != value_.map_->end() && (*it).first == key)
+    return (*it).second;
+  it = value_.map_->emplace_hint(it, std::piecewise_construct,
+                                 std::forward_as_tuple(std::move(key)),
+                                 std::forward_as_tuple());
+  return (*it).second;
+}
+
 void Value::dupMeta(const Value& other) {
+#if JSONCPP_COMPACT_VALUE
+  (void)other;
+#else
   comments_ = other.comments_;
   start_ = other.start_;
   limit_ = other.limit_;
+#endif
 }
 
 // Access an object value by name, create a null member if it does not exist.
@@ -3619,17 +4606,14 @@ bool Value::removeIndex(ArrayIndex index, Value* removed) {
     return false;
   }
   if (removed)
-    *removed = it->second;
-  ArrayIndex oldSize = size();
-  // shift left all items left, into the place of the "removed"
-  for (ArrayIndex i = index; i < (oldSize - 1); ++i) {
-    CZString keey(i);
-    (*value_.map_)[keey] = (*this)[i + 1];
-  }
+    *removed = std::move(it->second);
+  // shift all following items left by moving them into the place of the
+  // "removed" one; indices are contiguous, so map order is index order
+  auto next = it;
+  for (++next; next != value_.map_->end(); it = next, ++next)
+    it->second = std::move(next->second);
   // erase the last one ("leftover")
-  CZString keyLast(oldSize - 1);
-  auto itLast = value_.map_->find(keyLast);
-  value_.map_->erase(itLast);
+  value_.map_->erase(it);
   return true;
 }
 
@@ -3819,6 +4803,24 @@ void Value::Comments::set(CommentPlacement slot, String comment) {
   (*ptr_)[slot] = std::move(comment);
 }
 
+#if JSONCPP_COMPACT_VALUE
+// A compact Value has no room for comments: they are dropped.
+void Value::setComment(String /*comment*/, CommentPlacement /*placement*/) {}
+
+bool Value::hasComment(CommentPlacement /*placement*/) const { return false; }
+
+String Value::getComment(CommentPlacement /*placement*/) const {
+  return String();
+}
+
+void Value::setOffsetStart(ptrdiff_t /*start*/) {}
+
+void Value::setOffsetLimit(ptrdiff_t /*limit*/) {}
+
+ptrdiff_t Value::getOffsetStart() const { return 0; }
+
+ptrdiff_t Value::getOffsetLimit() const { return 0; }
+#else
 void Value::setComment(String comment, CommentPlacement placement) {
   if (!comment.empty() && (comment.back() == '\n')) {
     // Always discard trailing newline, to aid indentation.
@@ -3846,6 +4848,7 @@ void Value::setOffsetLimit(ptrdiff_t limit) { limit_ = limit; }
 ptrdiff_t Value::getOffsetStart() const { return start_; }
 
 ptrdiff_t Value::getOffsetLimit() const { return limit_; }
+#endif
 
 String Value::toStyledString() const {
   StreamWriterBuilder builder;
@@ -4072,6 +5075,7 @@ Value& Path::make(Value& root) const {
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <memory>
@@ -4186,6 +5190,26 @@ String valueToString(UInt value) { return valueToString(LargestUInt(value)); }
 #endif // # if defined(JSON_HAS_INT64)
 
 namespace {
+/// Shortest "%.*g" form of \c value that reads back to the same double.
+String shortestToString(double value) {
+#if JSONCPP_HAS_CHARCONV
+  char buffer[32];
+  std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  return String(buffer, result.ptr);
+#else
+  char buffer[32];
+  for (int precision = 15;; ++precision) {
+    jsoncpp_snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+    if (precision == 17 || std::strtod(buffer, nullptr) == value)
+      break;
+  }
+  String result(buffer);
+  result.erase(fixNumericLocale(result.begin(), result.end()), result.end());
+  return result;
+#endif
+}
+
 String valueToString(double value, bool useSpecialFloats,
                      unsigned int precision, PrecisionType precisionType) {
   // Print into the buffer. We need not request the alternative representation
@@ -4198,6 +5222,30 @@ String valueToString(double value, bool useSpecialFloats,
                [isnan(value) ? 0 : (value < 0) ? 1 : 2];
   }
 
+  if (precisionType == PrecisionType::shortestRoundTrip) {
+    String buffer = shortestToString(value);
+    if (buffer.find('.') == buffer.npos && buffer.find('e') == buffer.npos)
+      buffer += ".0";
+    return buffer;
+  }
+
+#if JSONCPP_HAS_CHARCONV
+  // to_chars with a precision prints exactly what printf("%.*g") does, minus
+  // the locale.
+  if (precisionType == PrecisionType::significantDigits) {
+    char chars[64];
+    std::to_chars_result result =
+        std::to_chars(chars, chars + sizeof(chars), value,
+                      std::chars_format::general, static_cast<int>(precision));
+    if (result.ec == std::errc()) {
+      String buffer(chars, result.ptr);
+      if (buffer.find('.') == buffer.npos && buffer.find('e') == buffer.npos)
+        buffer += ".0";
+      return buffer;
+    }
+  }
+#endif
+
   String buffer(size_t(36), '\0');
   while (true) {
     int len = jsoncpp_snprintf(
@@ -5243,8 +6291,11 @@ StreamWriter* StreamWriterBuilder::newStreamWriter() const {
     precisionType = PrecisionType::significantDigits;
   } else if (pt_str == "decimal") {
     precisionType = PrecisionType::decimalPlaces;
+  } else if (pt_str == "shortest") {
+    precisionType = PrecisionType::shortestRoundTrip;
   } else {
-    throwRuntimeError("precisionType must be 'significant' or 'decimal'");
+    throwRuntimeError(
+        "precisionType must be 'significant', 'decimal' or 'shortest'");
   }
   String colonSymbol = " : ";
   if (eyc) {